@@ -2,17 +2,25 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmCPackArchiveGenerator.h"
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <cm/memory>
+
 #include "cmCPackComponentGroup.h"
 #include "cmCPackGenerator.h"
 #include "cmCPackLog.h"
 #include "cmGeneratedFileStream.h"
+#include "cmLocale.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmValue.h"
@@ -48,14 +56,15 @@ private:
   DeduplicateStatus CompareFile(std::string const& path,
                                 std::string const& localTopLevel)
   {
+    std::string fullPath = cmStrCat(localTopLevel, '/', path);
     auto fileItr = this->Files.find(path);
     if (fileItr != this->Files.end()) {
-      return cmSystemTools::FilesDiffer(path, fileItr->second)
+      return cmSystemTools::FilesDiffer(fullPath, fileItr->second)
         ? DeduplicateStatus::Error
         : DeduplicateStatus::Skip;
     }
 
-    this->Files[path] = cmStrCat(localTopLevel, '/', path);
+    this->Files[path] = std::move(fullPath);
     return DeduplicateStatus::Add;
   }
 
@@ -79,14 +88,17 @@ private:
    * @brief Compares a symlink with already processed symlinks.
    *
    * @param path The path of the symlink to compare.
+   * @param localTopLevel The top-level directory for the symlink.
    * @return DeduplicateStatus indicating whether to add, skip, or flag an
    * error for the symlink.
    */
-  DeduplicateStatus CompareSymlink(std::string const& path)
+  DeduplicateStatus CompareSymlink(std::string const& path,
+                                   std::string const& localTopLevel)
   {
     auto symlinkItr = this->Symlink.find(path);
     std::string symlinkValue;
-    auto status = cmSystemTools::ReadSymlink(path, symlinkValue);
+    auto status = cmSystemTools::ReadSymlink(
+      cmStrCat(localTopLevel, '/', path), symlinkValue);
     if (!status.IsSuccess()) {
       return DeduplicateStatus::Error;
     }
@@ -107,7 +119,8 @@ public:
    * This method identifies whether the given path is a file, folder, or
    * symlink and then delegates to the appropriate comparison method.
    *
-   * @param path The path to check for deduplication.
+   * @param path The path to check for deduplication, relative to
+   * localTopLevel.
    * @param localTopLevel The top-level directory for the path.
    * @return DeduplicateStatus indicating the action to take for the given
    * path.
@@ -115,11 +128,12 @@ public:
   DeduplicateStatus IsDeduplicate(std::string const& path,
                                   std::string const& localTopLevel)
   {
+    std::string const fullPath = cmStrCat(localTopLevel, '/', path);
     DeduplicateStatus status;
-    if (cmSystemTools::FileIsDirectory(path)) {
+    if (cmSystemTools::FileIsDirectory(fullPath)) {
       status = this->CompareFolder(path);
-    } else if (cmSystemTools::FileIsSymlink(path)) {
-      status = this->CompareSymlink(path);
+    } else if (cmSystemTools::FileIsSymlink(fullPath)) {
+      status = this->CompareSymlink(path, localTopLevel);
     } else {
       status = this->CompareFile(path, localTopLevel);
     }
@@ -245,34 +259,55 @@ int cmCPackArchiveGenerator::InitializeInternal()
   return this->Superclass::InitializeInternal();
 }
 
-int cmCPackArchiveGenerator::addOneComponentToArchive(
-  cmArchiveWrite& archive, cmCPackComponent* component,
-  Deduplicator* deduplicator)
+/*
+ * Log a message from code that may run on a component packaging
+ * worker thread.  The logger itself is not thread-safe.
+ */
+#define cmCPackArchiveLogger(logType, msg)                                    \
+  do {                                                                        \
+    std::lock_guard<std::mutex> cmCPackArchive_lock(this->LoggerMutex);       \
+    cmCPackLogger(logType, msg);                                              \
+  } while (false)
+
+void cmCPackArchiveGenerator::PrepareComponentPackaging()
 {
-  cmCPackLogger(cmCPackLog::LOG_VERBOSE,
-                "   - packaging component: " << component->Name << std::endl);
-  // Add the files of this component to the archive
-  std::string localToplevel(this->GetOption("CPACK_TEMPORARY_DIRECTORY"));
-  localToplevel += "/" + this->GetSanitizedDirOrFileName(component->Name);
-  // Change to local toplevel
-  cmWorkingDirectory workdir(localToplevel);
-  if (workdir.Failed()) {
-    cmCPackLogger(cmCPackLog::LOG_ERROR, workdir.GetError() << std::endl);
-    return 0;
-  }
-  std::string filePrefix;
+  this->ComponentTemporaryDirectory =
+    this->GetOption("CPACK_TEMPORARY_DIRECTORY");
+  this->ComponentFilePrefix.clear();
   if (this->IsOn("CPACK_COMPONENT_INCLUDE_TOPLEVEL_DIRECTORY")) {
-    filePrefix = cmStrCat(this->GetOption("CPACK_PACKAGE_FILE_NAME"), '/');
+    this->ComponentFilePrefix =
+      cmStrCat(this->GetOption("CPACK_PACKAGE_FILE_NAME"), '/');
   }
   cmValue installPrefix = this->GetOption("CPACK_PACKAGING_INSTALL_PREFIX");
   if (installPrefix && installPrefix->size() > 1 &&
       (*installPrefix)[0] == '/') {
     // add to file prefix and remove the leading '/'
-    filePrefix += installPrefix->substr(1);
-    filePrefix += "/";
+    this->ComponentFilePrefix += installPrefix->substr(1);
+    this->ComponentFilePrefix += "/";
+  }
+}
+
+int cmCPackArchiveGenerator::addOneComponentToArchive(
+  cmArchiveWrite& archive, cmCPackComponent* component,
+  Deduplicator* deduplicator)
+{
+  cmCPackArchiveLogger(cmCPackLog::LOG_VERBOSE,
+                       "   - packaging component: " << component->Name
+                                                    << std::endl);
+  // Add the files of this component to the archive.  Files are added
+  // by full path so that several archives may be written concurrently
+  // without changing the working directory.
+  std::string const localToplevel =
+    cmStrCat(this->ComponentTemporaryDirectory, '/',
+             this->GetSanitizedDirOrFileName(component->Name));
+  if (!cmSystemTools::FileIsDirectory(localToplevel)) {
+    cmCPackArchiveLogger(cmCPackLog::LOG_ERROR,
+                         "Component directory does not exist: "
+                           << localToplevel << std::endl);
+    return 0;
   }
   for (std::string const& file : component->Files) {
-    std::string rp = filePrefix + file;
+    std::string rp = this->ComponentFilePrefix + file;
 
     DeduplicateStatus status = DeduplicateStatus::Add;
     if (deduplicator) {
@@ -280,22 +315,24 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
     }
 
     if (!deduplicator || status == DeduplicateStatus::Add) {
-      cmCPackLogger(cmCPackLog::LOG_DEBUG, "Adding file: " << rp << std::endl);
-      archive.Add(rp, 0, nullptr, false);
+      cmCPackArchiveLogger(cmCPackLog::LOG_DEBUG,
+                           "Adding file: " << rp << std::endl);
+      archive.Add(cmStrCat(localToplevel, '/', rp), localToplevel.size() + 1,
+                  nullptr, false);
     } else if (status == DeduplicateStatus::Error) {
-      cmCPackLogger(cmCPackLog::LOG_ERROR,
-                    "ERROR The data in files with the "
-                    "same filename is different.");
+      cmCPackArchiveLogger(cmCPackLog::LOG_ERROR,
+                           "ERROR The data in files with the "
+                           "same filename is different.");
       return 0;
     } else {
-      cmCPackLogger(cmCPackLog::LOG_DEBUG,
-                    "Passing file: " << rp << std::endl);
+      cmCPackArchiveLogger(cmCPackLog::LOG_DEBUG,
+                           "Passing file: " << rp << std::endl);
     }
 
     if (!archive) {
-      cmCPackLogger(cmCPackLog::LOG_ERROR,
-                    "ERROR while packaging files: " << archive.GetError()
-                                                    << std::endl);
+      cmCPackArchiveLogger(cmCPackLog::LOG_ERROR,
+                           "ERROR while packaging files: "
+                             << archive.GetError() << std::endl);
       return 0;
     }
   }
@@ -337,31 +374,21 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
 
 int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
 {
-  this->packageFileNames.clear();
+  std::vector<ComponentArchive> componentArchives;
   // The default behavior is to have one package by component group
   // unless CPACK_COMPONENTS_IGNORE_GROUP is specified.
   if (!ignoreGroup) {
-    for (auto const& compG : this->ComponentGroups) {
+    for (auto& compG : this->ComponentGroups) {
       cmCPackLogger(cmCPackLog::LOG_VERBOSE,
                     "Packaging component group: " << compG.first << std::endl);
       // Begin the archive for this group
-      std::string packageFileName = std::string(this->toplevel) + "/" +
+      ComponentArchive groupArchive;
+      groupArchive.PackageFileName = std::string(this->toplevel) + "/" +
         this->GetArchiveComponentFileName(compG.first, true);
-
-      Deduplicator deduplicator;
-
-      // open a block in order to automatically close archive
-      // at the end of the block
-      {
-        DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-        // now iterate over the component of this group
-        for (cmCPackComponent* comp : (compG.second).Components) {
-          // Add the files of this component to the archive
-          this->addOneComponentToArchive(archive, comp, &deduplicator);
-        }
-      }
-      // add the generated package to package file names list
-      this->packageFileNames.push_back(std::move(packageFileName));
+      // now iterate over the component of this group
+      groupArchive.Components = compG.second.Components;
+      groupArchive.Deduplicate = true;
+      componentArchives.push_back(std::move(groupArchive));
     }
     // Handle Orphan components (components not belonging to any groups)
     for (auto& comp : this->Components) {
@@ -373,17 +400,11 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
             << comp.second.Name
             << "> does not belong to any group, package it separately."
             << std::endl);
-        std::string packageFileName = std::string(this->toplevel);
-        packageFileName +=
+        ComponentArchive componentArchive;
+        componentArchive.PackageFileName = std::string(this->toplevel) +
           "/" + this->GetArchiveComponentFileName(comp.first, false);
-
-        {
-          DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-          // Add the files of this component to the archive
-          this->addOneComponentToArchive(archive, &(comp.second), nullptr);
-        }
-        // add the generated package to package file names list
-        this->packageFileNames.push_back(std::move(packageFileName));
+        componentArchive.Components.push_back(&comp.second);
+        componentArchives.push_back(std::move(componentArchive));
       }
     }
   }
@@ -391,18 +412,104 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
   // We build 1 package per component
   else {
     for (auto& comp : this->Components) {
-      std::string packageFileName = std::string(this->toplevel);
-      packageFileName +=
-        "/" + this->GetArchiveComponentFileName(comp.first, false);
-
-      {
-        DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-        // Add the files of this component to the archive
-        this->addOneComponentToArchive(archive, &(comp.second), nullptr);
-      }
-      // add the generated package to package file names list
-      this->packageFileNames.push_back(std::move(packageFileName));
+      ComponentArchive componentArchive;
+      componentArchive.PackageFileName = std::string(this->toplevel) + "/" +
+        this->GetArchiveComponentFileName(comp.first, false);
+      componentArchive.Components.push_back(&comp.second);
+      componentArchives.push_back(std::move(componentArchive));
+    }
+  }
+  return this->PackageComponentArchives(componentArchives);
+}
+
+int cmCPackArchiveGenerator::PackageComponentArchives(
+  std::vector<ComponentArchive> const& componentArchives)
+{
+  this->packageFileNames.clear();
+
+  // Everything that queries the CPack configuration is done here on the
+  // main thread.  This includes the archive headers, which some
+  // generators compute from options.
+  int const threads = this->GetThreadCount();
+  std::vector<std::unique_ptr<cmGeneratedFileStream>> streams;
+  streams.reserve(componentArchives.size());
+  for (ComponentArchive const& componentArchive : componentArchives) {
+    auto gf = cm::make_unique<cmGeneratedFileStream>();
+    gf->Open(componentArchive.PackageFileName, false, true);
+    if (!this->GenerateHeader(gf.get())) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Problem to generate Header for archive <"
+                      << componentArchive.PackageFileName << ">."
+                      << std::endl);
+      return 0;
     }
+    streams.push_back(std::move(gf));
+  }
+
+  unsigned int const jobs =
+    this->GetComponentJobCount(componentArchives.size());
+  std::vector<int> results(componentArchives.size(), 1);
+  auto writeArchive = [&](std::size_t i) {
+    ComponentArchive const& componentArchive = componentArchives[i];
+    Deduplicator deduplicator;
+    // The archive is finalized when it goes out of scope.
+    cmArchiveWrite archive(*streams[i], this->Compress, this->ArchiveFormat,
+                           0, threads);
+    // The workers share the locale set by the main thread below.
+    archive.SetSwitchLocale(jobs <= 1);
+    if (!archive.Open() || !archive) {
+      cmCPackArchiveLogger(cmCPackLog::LOG_ERROR,
+                           "Problem to create archive <"
+                             << componentArchive.PackageFileName
+                             << ">, ERROR = " << archive.GetError()
+                             << std::endl);
+      results[i] = 0;
+      return;
+    }
+    for (cmCPackComponent* comp : componentArchive.Components) {
+      // Add the files of this component to the archive
+      this->addOneComponentToArchive(
+        archive, comp, componentArchive.Deduplicate ? &deduplicator : nullptr);
+    }
+  };
+
+  if (jobs <= 1) {
+    for (std::size_t i = 0; i < componentArchives.size(); ++i) {
+      writeArchive(i);
+    }
+  } else {
+    cmCPackLogger(cmCPackLog::LOG_VERBOSE,
+                  "Packaging " << componentArchives.size()
+                               << " component archives using " << jobs
+                               << " jobs" << std::endl);
+    // setlocale() is not thread-safe, so the locale each archive entry
+    // needs is set once here for all workers instead of per entry.
+    cmLocaleRAII localeRAII;
+    static_cast<void>(localeRAII);
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> workers;
+    workers.reserve(jobs);
+    for (unsigned int j = 0; j < jobs; ++j) {
+      workers.emplace_back([&]() {
+        for (std::size_t i = next++; i < componentArchives.size();
+             i = next++) {
+          writeArchive(i);
+        }
+      });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // Close the archives and record the package file names in the same
+  // order regardless of the number of jobs.
+  for (std::size_t i = 0; i < componentArchives.size(); ++i) {
+    streams[i].reset();
+    if (!results[i]) {
+      return 0;
+    }
+    this->packageFileNames.push_back(componentArchives[i].PackageFileName);
   }
   return 1;
 }
@@ -418,6 +525,7 @@ int cmCPackArchiveGenerator::PackageComponentsAllInOne()
                 "(CPACK_COMPONENTS_ALL_GROUPS_IN_ONE_PACKAGE is set)"
                   << std::endl);
   DECLARE_AND_OPEN_ARCHIVE(packageFileNames[0], archive);
+  this->PrepareComponentPackaging();
 
   Deduplicator deduplicator;
 
@@ -443,6 +551,7 @@ int cmCPackArchiveGenerator::PackageFiles()
     if (this->componentPackageMethod == ONE_PACKAGE) {
       return this->PackageComponentsAllInOne();
     }
+    this->PrepareComponentPackaging();
     // CASE 2 : COMPONENT CLASSICAL package(s) (i.e. not all-in-one)
     // There will be 1 package for each component group
     // however one may require to ignore component group and
@@ -503,3 +612,22 @@ int cmCPackArchiveGenerator::GetThreadCount() const
 
   return threads;
 }
+
+unsigned int cmCPackArchiveGenerator::GetComponentJobCount(
+  std::size_t archiveCount) const
+{
+  unsigned long jobs = 1;
+  if (cmValue v = this->GetOptionIfSet("CPACK_ARCHIVE_COMPONENT_JOBS")) {
+    if (!cmStrToULong(*v, &jobs)) {
+      cmCPackLogger(cmCPackLog::LOG_WARNING,
+                    "Ignoring invalid CPACK_ARCHIVE_COMPONENT_JOBS value: "
+                      << *v << std::endl);
+      jobs = 1;
+    }
+  }
+  if (jobs == 0) {
+    jobs = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  return static_cast<unsigned int>(
+    std::min<unsigned long>(jobs, std::max<std::size_t>(archiveCount, 1)));
+}
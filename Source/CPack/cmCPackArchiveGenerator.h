@@ -4,8 +4,11 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <iosfwd>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "cmArchiveWrite.h"
 #include "cmCPackGenerator.h"
@@ -51,6 +54,16 @@ private:
 
   class Deduplicator;
 
+  /**
+   * One archive to be written by PackageComponentArchives.
+   */
+  struct ComponentArchive
+  {
+    std::string PackageFileName;
+    std::vector<cmCPackComponent*> Components;
+    bool Deduplicate = false;
+  };
+
 protected:
   int InitializeInternal() override;
   /**
@@ -77,6 +90,13 @@ protected:
    * archive for each component group.
    */
   int PackageComponents(bool ignoreGroup);
+  /**
+   * Write the given component archives, using up to
+   * CPACK_ARCHIVE_COMPONENT_JOBS concurrent jobs.  The package
+   * file names are recorded in the order given.
+   */
+  int PackageComponentArchives(
+    std::vector<ComponentArchive> const& componentArchives);
   /**
    * Special case of component install where all
    * components will be put in a single installer.
@@ -92,9 +112,17 @@ private:
   }
 
   int GetThreadCount() const;
+  unsigned int GetComponentJobCount(std::size_t archiveCount) const;
+
+  // Read the options used by addOneComponentToArchive up front so that
+  // it does not query the configuration from worker threads.
+  void PrepareComponentPackaging();
 
 private:
   cmArchiveWrite::Compress Compress;
   std::string ArchiveFormat;
   std::string OutputExtension;
+  std::string ComponentTemporaryDirectory;
+  std::string ComponentFilePrefix;
+  std::mutex LoggerMutex;
 };
@@ -45,8 +45,10 @@ public:
 private:
   void generateDebianBinaryFile() const;
   void generateControlFile() const;
-  bool generateDataTar() const;
-  std::string generateMD5File() const;
+  bool generateDataTar(
+    std::map<std::string, std::string>& contentHashes) const;
+  std::string generateMD5File(
+    std::map<std::string, std::string> const& contentHashes) const;
   bool generateControlTar(std::string const& md5Filename) const;
   bool generateDeb() const;
 
@@ -141,10 +143,13 @@ bool DebGenerator::generate() const
 {
   this->generateDebianBinaryFile();
   this->generateControlFile();
-  if (!this->generateDataTar()) {
+  // The md5sums are computed while the data archive is written
+  // so that every packaged file is read only once.
+  std::map<std::string, std::string> contentHashes;
+  if (!this->generateDataTar(contentHashes)) {
     return false;
   }
-  std::string md5Filename = this->generateMD5File();
+  std::string md5Filename = this->generateMD5File(contentHashes);
   if (!this->generateControlTar(md5Filename)) {
     return false;
   }
@@ -179,7 +184,8 @@ void DebGenerator::generateControlFile() const
   out << "Installed-Size: " << (totalSize + 1023) / 1024 << "\n\n";
 }
 
-bool DebGenerator::generateDataTar() const
+bool DebGenerator::generateDataTar(
+  std::map<std::string, std::string>& contentHashes) const
 {
   std::string filename_data_tar =
     this->WorkDir + "/data.tar" + this->CompressionSuffix;
@@ -206,6 +212,7 @@ bool DebGenerator::generateDataTar() const
   // always uid/gid equal to 0.
   data_tar.SetUIDAndGID(0U, 0U);
   data_tar.SetUNAMEAndGNAME("root", "root");
+  data_tar.SetContentHashAlgorithm(cmCryptoHash::AlgoMD5);
 
   // now add all directories which have to be compressed
   // collect all top level install dirs for that
@@ -272,10 +279,12 @@ bool DebGenerator::generateDataTar() const
       return false;
     }
   }
+  contentHashes = data_tar.GetContentHashes();
   return true;
 }
 
-std::string DebGenerator::generateMD5File() const
+std::string DebGenerator::generateMD5File(
+  std::map<std::string, std::string> const& contentHashes) const
 {
   std::string md5filename = this->WorkDir + "/md5sums";
 
@@ -290,8 +299,14 @@ std::string DebGenerator::generateMD5File() const
       continue;
     }
 
-    cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
-    std::string output = hasher.HashFile(file);
+    std::string output;
+    auto hashIt = contentHashes.find(file);
+    if (hashIt != contentHashes.end()) {
+      output = hashIt->second;
+    } else {
+      cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+      output = hasher.HashFile(file);
+    }
     if (output.empty()) {
       cmCPackLogger(cmCPackLog::LOG_ERROR,
                     "Problem computing the md5 of " << file << std::endl);
@@ -12,6 +12,8 @@
 #include <thread>
 
 #include <cm/algorithm>
+#include <cm/memory>
+#include <cm/optional>
 
 #include <cm3p/archive.h>
 #include <cm3p/archive_entry.h>
@@ -278,6 +280,11 @@ cmArchiveWrite::~cmArchiveWrite()
   archive_write_free(this->Archive);
 }
 
+void cmArchiveWrite::SetContentHashAlgorithm(cmCryptoHash::Algo algo)
+{
+  this->ContentHash = cm::make_unique<cmCryptoHash>(algo);
+}
+
 bool cmArchiveWrite::Add(std::string path, size_t skip, char const* prefix,
                          bool recursive)
 {
@@ -333,8 +340,10 @@ bool cmArchiveWrite::AddFile(char const* file, size_t skip, char const* prefix)
   }
   char const* out = file + skip;
 
-  cmLocaleRAII localeRAII;
-  static_cast<void>(localeRAII);
+  cm::optional<cmLocaleRAII> localeRAII;
+  if (this->SwitchLocale) {
+    localeRAII.emplace();
+  }
 
   // Meta-data.
   std::string dest = cmStrCat(prefix ? prefix : "", out);
@@ -421,6 +430,9 @@ bool cmArchiveWrite::AddFile(char const* file, size_t skip, char const* prefix)
     if (size_t size = static_cast<size_t>(archive_entry_size(e))) {
       return this->AddData(file, size);
     }
+    if (this->ContentHash && archive_entry_filetype(e) == AE_IFREG) {
+      this->ContentHashes[file] = this->ContentHash->HashString("");
+    }
   }
   return true;
 }
@@ -434,6 +446,10 @@ bool cmArchiveWrite::AddData(char const* file, size_t size)
     return false;
   }
 
+  if (this->ContentHash) {
+    this->ContentHash->Initialize();
+  }
+
   char buffer[16384];
   size_t nleft = size;
   while (nleft > 0) {
@@ -452,6 +468,9 @@ bool cmArchiveWrite::AddData(char const* file, size_t size)
                              cm_archive_error_string(this->Archive));
       return false;
     }
+    if (this->ContentHash) {
+      this->ContentHash->Append(buffer, nnext);
+    }
     nleft -= nnext;
   }
   if (nleft > 0) {
@@ -459,5 +478,8 @@ bool cmArchiveWrite::AddData(char const* file, size_t size)
                            "\": ", cmSystemTools::GetLastSystemError());
     return false;
   }
+  if (this->ContentHash) {
+    this->ContentHashes[file] = this->ContentHash->FinalizeHex();
+  }
   return true;
 }
@@ -6,8 +6,12 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <map>
+#include <memory>
 #include <string>
 
+#include "cmCryptoHash.h"
+
 #if defined(CMAKE_BOOTSTRAP)
 #  error "cmArchiveWrite not allowed during bootstrap build!"
 #endif
@@ -90,6 +94,22 @@ public:
 
   void SetMTime(std::string const& t) { this->MTime = t; }
 
+  //! Switch LC_CTYPE to the user's locale while each file is added.
+  //! Disable this when the caller holds the locale for the whole archive,
+  //! for example because several archives are written concurrently.
+  void SetSwitchLocale(bool s) { this->SwitchLocale = s; }
+
+  //! Hash the content of every regular file while it is written to the
+  //! archive so that callers needing checksums do not read it again.
+  void SetContentHashAlgorithm(cmCryptoHash::Algo algo);
+
+  //! Returns the hex digest of each regular file added so far, keyed by
+  //! the on-disk path of the file as given to Add.
+  std::map<std::string, std::string> const& GetContentHashes() const
+  {
+    return this->ContentHashes;
+  }
+
   //! Sets the permissions of the added files/folders
   void SetPermissions(int permissions_)
   {
@@ -157,6 +177,7 @@ private:
   struct archive* Archive;
   struct archive* Disk;
   bool Verbose = false;
+  bool SwitchLocale = true;
   std::string Format;
   std::string Error;
   std::string MTime;
@@ -176,4 +197,8 @@ private:
   //! Permissions on files/folders
   cmArchiveWriteOptional<int> Permissions;
   cmArchiveWriteOptional<int> PermissionsMask;
+
+  //! Content hashing of added files, if enabled
+  std::unique_ptr<cmCryptoHash> ContentHash;
+  std::map<std::string, std::string> ContentHashes;
 };
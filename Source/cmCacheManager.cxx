@@ -3,14 +3,17 @@
 #include "cmCacheManager.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 
+#include "cmCryptoHash.h"
 #include "cmGeneratedFileStream.h"
 #include "cmList.h"
 #include "cmMessageType.h"
@@ -43,78 +46,44 @@ bool cmCacheManager::LoadCache(std::string const& path, bool internal,
     return false;
   }
 
-  cmsys::ifstream fin(cacheFile.c_str());
-  if (!fin) {
+  std::string content;
+  if (!cmCacheManager::ReadCacheFile(cacheFile, content)) {
     return false;
   }
-  char const* realbuffer;
-  std::string buffer;
-  std::string entryKey;
-  unsigned int lineno = 0;
-  while (fin) {
-    // Format is key:type=value
-    std::string helpString;
-    CacheEntry e;
-    cmSystemTools::GetLineFromStream(fin, buffer);
-    lineno++;
-    realbuffer = buffer.c_str();
-    while (*realbuffer == ' ' || *realbuffer == '\t' || *realbuffer == '\r' ||
-           *realbuffer == '\n') {
-      if (*realbuffer == '\n') {
-        lineno++;
-      }
-      realbuffer++;
-    }
-    // skip blank lines and comment lines
-    if (realbuffer[0] == '#' || realbuffer[0] == 0) {
+  std::vector<CacheRecord> records;
+  if (!cmCacheManager::ReadBinaryCache(path, content, records)) {
+    cmCacheManager::ParseCacheFile(cacheFile, content, records);
+  }
+  for (CacheRecord& record : records) {
+    if (excludes.find(record.Key) != excludes.end()) {
       continue;
     }
-    while (realbuffer[0] == '/' && realbuffer[1] == '/') {
-      if ((realbuffer[2] == '\\') && (realbuffer[3] == 'n')) {
-        helpString += '\n';
-        helpString += &realbuffer[4];
-      } else {
-        helpString += &realbuffer[2];
+    // Load internal values if internal is set.
+    // If the entry is not internal to the cache being loaded
+    // or if it is in the list of internal entries to be
+    // imported, load it.
+    if (internal || (record.Type != cmStateEnums::INTERNAL) ||
+        (includes.find(record.Key) != includes.end())) {
+      CacheEntry e;
+      e.Value = std::move(record.Value);
+      e.Type = record.Type;
+      e.SetProperty("HELPSTRING", record.HelpString);
+      // If we are loading the cache from another project,
+      // make all loaded entries internal so that it is
+      // not visible in the gui
+      if (!internal) {
+        e.Type = cmStateEnums::INTERNAL;
+        e.SetProperty("HELPSTRING",
+                      cmStrCat("DO NOT EDIT, ", record.Key,
+                               " loaded from external file.  "
+                               "To change this value edit this file: ",
+                               path, "/CMakeCache.txt"));
       }
-      cmSystemTools::GetLineFromStream(fin, buffer);
-      lineno++;
-      realbuffer = buffer.c_str();
-      if (!fin) {
-        continue;
+      if (!this->ReadPropertyEntry(record.Key, e)) {
+        e.Initialized = true;
+        this->Cache[record.Key] = std::move(e);
       }
     }
-    e.SetProperty("HELPSTRING", helpString);
-    if (cmState::ParseCacheEntry(realbuffer, entryKey, e.Value, e.Type)) {
-      if (excludes.find(entryKey) == excludes.end()) {
-        // Load internal values if internal is set.
-        // If the entry is not internal to the cache being loaded
-        // or if it is in the list of internal entries to be
-        // imported, load it.
-        if (internal || (e.Type != cmStateEnums::INTERNAL) ||
-            (includes.find(entryKey) != includes.end())) {
-          // If we are loading the cache from another project,
-          // make all loaded entries internal so that it is
-          // not visible in the gui
-          if (!internal) {
-            e.Type = cmStateEnums::INTERNAL;
-            helpString = cmStrCat("DO NOT EDIT, ", entryKey,
-                                  " loaded from external file.  "
-                                  "To change this value edit this file: ",
-                                  path, "/CMakeCache.txt");
-            e.SetProperty("HELPSTRING", helpString);
-          }
-          if (!this->ReadPropertyEntry(entryKey, e)) {
-            e.Initialized = true;
-            this->Cache[entryKey] = e;
-          }
-        }
-      }
-    } else {
-      std::ostringstream error;
-      error << "Parse error in cache file " << cacheFile << " on line "
-            << lineno << ". Offending entry: " << realbuffer;
-      cmSystemTools::Error(error.str());
-    }
   }
   this->CacheMajorVersion = 0;
   this->CacheMinorVersion = 0;
@@ -166,6 +135,263 @@ bool cmCacheManager::LoadCache(std::string const& path, bool internal,
   return true;
 }
 
+bool cmCacheManager::ReadCacheFile(std::string const& cacheFile,
+                                   std::string& content)
+{
+  cmsys::ifstream fin(cacheFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::ostringstream contents;
+  contents << fin.rdbuf();
+  content = contents.str();
+  return true;
+}
+
+void cmCacheManager::ParseCacheFile(std::string const& cacheFile,
+                                    std::string const& content,
+                                    std::vector<CacheRecord>& records)
+{
+  std::istringstream fin(content);
+  char const* realbuffer;
+  std::string buffer;
+  unsigned int lineno = 0;
+  while (fin) {
+    // Format is key:type=value
+    CacheRecord record;
+    cmSystemTools::GetLineFromStream(fin, buffer);
+    lineno++;
+    realbuffer = buffer.c_str();
+    while (*realbuffer == ' ' || *realbuffer == '\t' || *realbuffer == '\r' ||
+           *realbuffer == '\n') {
+      if (*realbuffer == '\n') {
+        lineno++;
+      }
+      realbuffer++;
+    }
+    // skip blank lines and comment lines
+    if (realbuffer[0] == '#' || realbuffer[0] == 0) {
+      continue;
+    }
+    while (realbuffer[0] == '/' && realbuffer[1] == '/') {
+      if ((realbuffer[2] == '\\') && (realbuffer[3] == 'n')) {
+        record.HelpString += '\n';
+        record.HelpString += &realbuffer[4];
+      } else {
+        record.HelpString += &realbuffer[2];
+      }
+      cmSystemTools::GetLineFromStream(fin, buffer);
+      lineno++;
+      realbuffer = buffer.c_str();
+      if (!fin) {
+        continue;
+      }
+    }
+    if (cmState::ParseCacheEntry(realbuffer, record.Key, record.Value,
+                                 record.Type)) {
+      records.emplace_back(std::move(record));
+    } else {
+      std::ostringstream error;
+      error << "Parse error in cache file " << cacheFile << " on line "
+            << lineno << ". Offending entry: " << realbuffer;
+      cmSystemTools::Error(error.str());
+    }
+  }
+}
+
+namespace {
+// The binary cache is only valid for the CMake version that wrote it,
+// and for the CMakeCache.txt content whose hash it records.
+std::string BinaryCacheHeader()
+{
+  return cmStrCat("CMakeCache binary ", cmVersion::GetCMakeVersion(), '\n');
+}
+
+template <typename T>
+void WriteBinary(std::string& out, T value)
+{
+  out.append(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+void WriteBinary(std::string& out, std::string const& value)
+{
+  WriteBinary(out, static_cast<std::uint32_t>(value.size()));
+  out.append(value);
+}
+
+class BinaryReader
+{
+public:
+  BinaryReader(std::string const& data, std::string::size_type pos)
+    : Data(data)
+    , Pos(pos)
+  {
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->Data.size() - this->Pos < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, this->Data.data() + this->Pos, sizeof(value));
+    this->Pos += sizeof(value);
+    return true;
+  }
+
+  bool Read(std::string& value)
+  {
+    std::uint32_t size;
+    if (!this->Read(size) || this->Data.size() - this->Pos < size) {
+      return false;
+    }
+    value.assign(this->Data, this->Pos, size);
+    this->Pos += size;
+    return true;
+  }
+
+  bool AtEnd() const { return this->Pos == this->Data.size(); }
+
+private:
+  std::string const& Data;
+  std::string::size_type Pos;
+};
+
+std::string BinaryCacheFile(std::string const& path)
+{
+  return cmStrCat(path, "/CMakeFiles/CMakeCache.bin");
+}
+
+// CMakeCache.txt is written in text mode, so its line endings depend on
+// the platform.  They do not change how it is parsed.
+std::string CacheContentHash(std::string content)
+{
+  cmSystemTools::ReplaceString(content, "\r\n", "\n");
+  return cmCryptoHash(cmCryptoHash::AlgoSHA256).HashString(content);
+}
+
+// Whether parsing the text written for an entry gives the same entry.
+bool ReadsBackExactly(std::string const& key, std::string const& value,
+                      std::string const& helpString)
+{
+  // Keys are written without escapes, and leading blanks or a '#' would
+  // make the line skipped or trimmed.
+  if (key.empty() || key.find_first_of("=\"\r\n") != std::string::npos ||
+      key[0] == ' ' || key[0] == '\t' || key[0] == '#') {
+    return false;
+  }
+  // Values are truncated at a newline and trailing blanks are trimmed
+  // unless the value is quoted, which also removes quotes it has.
+  if (value.find_first_of("\r\n") != std::string::npos) {
+    return false;
+  }
+  bool const quoted =
+    !value.empty() && (value.back() == ' ' || value.back() == '\t');
+  if (!quoted && value.size() >= 2 && value.front() == '\'' &&
+      value.back() == '\'') {
+    return false;
+  }
+  return helpString.find('\r') == std::string::npos &&
+    helpString.find("\\n") == std::string::npos;
+}
+}
+
+bool cmCacheManager::ReadBinaryCache(std::string const& path,
+                                     std::string const& content,
+                                     std::vector<CacheRecord>& records)
+{
+  // Read the whole file at once; it is only used if it describes the
+  // current content of CMakeCache.txt.
+  std::string data;
+  {
+    cmsys::ifstream fin(BinaryCacheFile(path).c_str(),
+                        std::ios::in | std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    std::ostringstream contents;
+    contents << fin.rdbuf();
+    data = contents.str();
+  }
+  std::string const header = BinaryCacheHeader();
+  if (data.compare(0, header.size(), header) != 0) {
+    return false;
+  }
+
+  BinaryReader reader(data, header.size());
+  std::string hash;
+  std::uint64_t count;
+  if (!reader.Read(hash) || !reader.Read(count) || count > data.size() ||
+      hash != CacheContentHash(content)) {
+    return false;
+  }
+
+  records.resize(static_cast<std::size_t>(count));
+  for (CacheRecord& record : records) {
+    std::uint8_t type;
+    if (!reader.Read(type) || !reader.Read(record.Key) ||
+        !reader.Read(record.Value) || !reader.Read(record.HelpString)) {
+      records.clear();
+      return false;
+    }
+    record.Type = static_cast<cmStateEnums::CacheEntryType>(type);
+  }
+  if (!reader.AtEnd()) {
+    records.clear();
+    return false;
+  }
+  return true;
+}
+
+void cmCacheManager::RecordEntry(WrittenRecords& records,
+                                 std::string const& key,
+                                 cmStateEnums::CacheEntryType type,
+                                 std::string const& value,
+                                 std::string const& helpString)
+{
+  if (!records) {
+    return;
+  }
+  if (!ReadsBackExactly(key, value, helpString)) {
+    records = cm::nullopt;
+    return;
+  }
+  CacheRecord record;
+  record.Key = key;
+  record.Value = value;
+  record.HelpString = helpString;
+  record.Type = type;
+  records->emplace_back(std::move(record));
+}
+
+bool cmCacheManager::WriteBinaryCache(std::string const& path,
+                                      std::string const& content,
+                                      std::vector<CacheRecord> const& records)
+{
+  std::string data = BinaryCacheHeader();
+  WriteBinary(data, CacheContentHash(content));
+  WriteBinary(data, static_cast<std::uint64_t>(records.size()));
+  for (CacheRecord const& record : records) {
+    WriteBinary(data, static_cast<std::uint8_t>(record.Type));
+    WriteBinary(data, record.Key);
+    WriteBinary(data, record.Value);
+    WriteBinary(data, record.HelpString);
+  }
+
+  // Replace the file atomically so a concurrent load never sees a
+  // partially written cache.
+  std::string const binaryFile = BinaryCacheFile(path);
+  std::string const tempFile = cmStrCat(binaryFile, ".tmp");
+  {
+    cmsys::ofstream fout(tempFile.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fout || !fout.write(data.data(), data.size())) {
+      return false;
+    }
+  }
+  return cmSystemTools::RenameFile(tempFile, binaryFile);
+}
+
 char const* cmCacheManager::PersistentProperties[] = { "ADVANCED", "MODIFIED",
                                                        "STRINGS" };
 
@@ -200,7 +426,8 @@ bool cmCacheManager::ReadPropertyEntry(std::string const& entryKey,
 void cmCacheManager::WritePropertyEntries(std::ostream& os,
                                           std::string const& entryKey,
                                           CacheEntry const& e,
-                                          cmMessenger* messenger) const
+                                          cmMessenger* messenger,
+                                          WrittenRecords& records) const
 {
   for (char const* p : cmCacheManager::PersistentProperties) {
     if (cmValue value = e.GetProperty(p)) {
@@ -215,6 +442,8 @@ void cmCacheManager::WritePropertyEntries(std::ostream& os,
       os << '\n';
       cmCacheManager::OutputNewlineTruncationWarning(os, key, *value,
                                                      messenger);
+      cmCacheManager::RecordEntry(records, key, cmStateEnums::INTERNAL,
+                                  *value, helpstring);
     }
   }
 }
@@ -222,9 +451,9 @@ void cmCacheManager::WritePropertyEntries(std::ostream& os,
 bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
 {
   std::string cacheFile = cmStrCat(path, "/CMakeCache.txt");
-  cmGeneratedFileStream fout(cacheFile);
-  fout.SetCopyIfDifferent(true);
-  if (!fout) {
+  cmGeneratedFileStream cacheStream(cacheFile);
+  cacheStream.SetCopyIfDifferent(true);
+  if (!cacheStream) {
     cmSystemTools::Error("Unable to open cache file for save. " + cacheFile);
     cmSystemTools::ReportLastSystemError("");
     return false;
@@ -261,6 +490,11 @@ bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
                       " was created",
                       cmStateEnums::INTERNAL);
 
+  // The text is kept to record its hash in the binary form, which is
+  // built from the entries as they are written.
+  std::ostringstream fout;
+  WrittenRecords records = std::vector<CacheRecord>();
+
   /* clang-format off */
   fout << "# This is the CMakeCache file.\n"
           "# For build in directory: " << currentcwd << "\n"
@@ -296,11 +530,9 @@ bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
       */
     } else if (t != cmStateEnums::INTERNAL) {
       // Format is key:type=value
-      if (cmValue help = ce.GetProperty("HELPSTRING")) {
-        cmCacheManager::OutputHelpString(fout, *help);
-      } else {
-        cmCacheManager::OutputHelpString(fout, "Missing description");
-      }
+      cmValue help = ce.GetProperty("HELPSTRING");
+      std::string const& helpString = help ? *help : "Missing description";
+      cmCacheManager::OutputHelpString(fout, helpString);
       cmCacheManager::OutputKey(fout, i.first);
       fout << ':' << cmState::CacheEntryTypeToString(t) << '=';
       cmCacheManager::OutputValue(fout, ce.Value);
@@ -308,6 +540,7 @@ bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
       cmCacheManager::OutputNewlineTruncationWarning(fout, i.first, ce.Value,
                                                      messenger);
       fout << '\n';
+      cmCacheManager::RecordEntry(records, i.first, t, ce.Value, helpString);
     }
   }
 
@@ -323,10 +556,11 @@ bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
     }
 
     cmStateEnums::CacheEntryType t = i.second.GetType();
-    this->WritePropertyEntries(fout, i.first, i.second, messenger);
+    this->WritePropertyEntries(fout, i.first, i.second, messenger, records);
     if (t == cmStateEnums::INTERNAL) {
       // Format is key:type=value
-      if (cmValue help = i.second.GetProperty("HELPSTRING")) {
+      cmValue help = i.second.GetProperty("HELPSTRING");
+      if (help) {
         cmCacheManager::OutputHelpString(fout, *help);
       }
       cmCacheManager::OutputKey(fout, i.first);
@@ -335,12 +569,23 @@ bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
       fout << '\n';
       cmCacheManager::OutputNewlineTruncationWarning(
         fout, i.first, i.second.GetValue(), messenger);
+      cmCacheManager::RecordEntry(records, i.first, t, i.second.GetValue(),
+                                  help ? *help : std::string());
     }
   }
   fout << '\n';
-  fout.Close();
+  std::string const content = fout.str();
+  cacheStream << content;
+  cacheStream.Close();
   std::string checkCacheFile = cmStrCat(path, "/CMakeFiles");
   cmSystemTools::MakeDirectory(checkCacheFile);
+
+  // Regenerate the binary form for the text just written.  Without one,
+  // the next load parses the text.
+  if (!records || !cmCacheManager::WriteBinaryCache(path, content, *records)) {
+    cmSystemTools::RemoveFile(BinaryCacheFile(path));
+  }
+
   checkCacheFile += "/cmake.check_cache";
   cmsys::ofstream checkCache(checkCacheFile.c_str());
   if (!checkCache) {
@@ -11,6 +11,8 @@
 #include <utility>
 #include <vector>
 
+#include <cm/optional>
+
 #include "cmPropertyMap.h"
 #include "cmStateTypes.h"
 #include "cmValue.h"
@@ -199,6 +201,38 @@ private:
   //! Clean out the CMakeFiles directory if no CMakeCache.txt
   void CleanCMakeFiles(std::string const& path);
 
+  //! An entry as written in CMakeCache.txt
+  struct CacheRecord
+  {
+    std::string Key;
+    std::string Value;
+    std::string HelpString;
+    cmStateEnums::CacheEntryType Type = cmStateEnums::UNINITIALIZED;
+  };
+  static bool ReadCacheFile(std::string const& cacheFile,
+                            std::string& content);
+  static void ParseCacheFile(std::string const& cacheFile,
+                             std::string const& content,
+                             std::vector<CacheRecord>& records);
+
+  //! Read and write the binary form of CMakeCache.txt kept in CMakeFiles
+  //! to load the cache without parsing it while the text is unchanged.
+  //! It is keyed by a hash of the CMakeCache.txt content.
+  static bool ReadBinaryCache(std::string const& path,
+                              std::string const& content,
+                              std::vector<CacheRecord>& records);
+  static bool WriteBinaryCache(std::string const& path,
+                               std::string const& content,
+                               std::vector<CacheRecord> const& records);
+
+  //! The records of the entries written to CMakeCache.txt, or nothing
+  //! once an entry would not be parsed back as it was written.
+  using WrittenRecords = cm::optional<std::vector<CacheRecord>>;
+  static void RecordEntry(WrittenRecords& records, std::string const& key,
+                          cmStateEnums::CacheEntryType type,
+                          std::string const& value,
+                          std::string const& helpString);
+
   static void OutputHelpString(std::ostream& fout,
                                std::string const& helpString);
   static void OutputWarningComment(std::ostream& fout,
@@ -216,7 +250,8 @@ private:
   static char const* PersistentProperties[];
   bool ReadPropertyEntry(std::string const& key, CacheEntry const& e);
   void WritePropertyEntries(std::ostream& os, std::string const& entryKey,
-                            CacheEntry const& e, cmMessenger* messenger) const;
+                            CacheEntry const& e, cmMessenger* messenger,
+                            WrittenRecords& records) const;
 
   std::map<std::string, CacheEntry> Cache;
   bool CacheLoaded = false;
@@ -31,6 +31,17 @@ void cmComputeComponentGraph::Compute()
 void cmComputeComponentGraph::Tarjan()
 {
   size_t n = this->InputGraph.size();
+
+  // Flatten the edge destinations for the traversal.
+  this->EdgeOffsets.clear();
+  this->EdgeOffsets.reserve(n + 1);
+  this->EdgeTargets.clear();
+  this->EdgeOffsets.push_back(0);
+  for (EdgeList const& nl : this->InputGraph) {
+    this->EdgeTargets.insert(this->EdgeTargets.end(), nl.begin(), nl.end());
+    this->EdgeOffsets.push_back(this->EdgeTargets.size());
+  }
+
   TarjanEntry entry = { 0, 0 };
   this->TarjanEntries.resize(0);
   this->TarjanEntries.resize(n, entry);
@@ -52,19 +63,20 @@ void cmComputeComponentGraph::Tarjan()
 
 void cmComputeComponentGraph::TarjanVisit(size_t i)
 {
-  // We are now visiting this node.
-  this->TarjanVisited[i] = this->TarjanWalkId;
-
-  // Initialize the entry.
-  this->TarjanEntries[i].Root = i;
-  this->TarjanComponents[i] = INVALID_COMPONENT;
-  this->TarjanEntries[i].VisitIndex = ++this->TarjanIndex;
-  this->TarjanStack.push(i);
+  this->TarjanEnter(i);
+  while (!this->TarjanFrames.empty()) {
+    TarjanFrame& frame = this->TarjanFrames.back();
+    size_t const k = frame.Node;
+
+    // Check if we have followed all outgoing edges.
+    if (frame.Edge == this->EdgeOffsets[k + 1]) {
+      this->TarjanFrames.pop_back();
+      this->TarjanLeave(k);
+      continue;
+    }
 
-  // Follow outgoing edges.
-  EdgeList const& nl = this->InputGraph[i];
-  for (cmGraphEdge const& ni : nl) {
-    size_t j = ni;
+    // Follow the next outgoing edge.
+    size_t j = this->EdgeTargets[frame.Edge];
 
     // Ignore edges to nodes that have been reached by a previous DFS
     // walk.  Since we did not reach the current node from that walk
@@ -72,24 +84,46 @@ void cmComputeComponentGraph::TarjanVisit(size_t i)
     // been assigned to a component.
     if (this->TarjanVisited[j] > 0 &&
         this->TarjanVisited[j] < this->TarjanWalkId) {
+      ++frame.Edge;
       continue;
     }
 
-    // Visit the destination if it has not yet been visited.
+    // Visit the destination if it has not yet been visited.  We come
+    // back to this edge once the visit is complete.
     if (!this->TarjanVisited[j]) {
-      this->TarjanVisit(j);
+      this->TarjanEnter(j);
+      continue;
     }
 
     // If the destination has not yet been assigned to a component,
     // check if it has a better root for the current object.
     if (this->TarjanComponents[j] == INVALID_COMPONENT) {
       if (this->TarjanEntries[this->TarjanEntries[j].Root].VisitIndex <
-          this->TarjanEntries[this->TarjanEntries[i].Root].VisitIndex) {
-        this->TarjanEntries[i].Root = this->TarjanEntries[j].Root;
+          this->TarjanEntries[this->TarjanEntries[k].Root].VisitIndex) {
+        this->TarjanEntries[k].Root = this->TarjanEntries[j].Root;
       }
     }
+    ++frame.Edge;
   }
+}
+
+void cmComputeComponentGraph::TarjanEnter(size_t i)
+{
+  // We are now visiting this node.
+  this->TarjanVisited[i] = this->TarjanWalkId;
+
+  // Initialize the entry.
+  this->TarjanEntries[i].Root = i;
+  this->TarjanComponents[i] = INVALID_COMPONENT;
+  this->TarjanEntries[i].VisitIndex = ++this->TarjanIndex;
+  this->TarjanStack.push_back(i);
 
+  // Follow outgoing edges.
+  this->TarjanFrames.push_back({ i, this->EdgeOffsets[i] });
+}
+
+void cmComputeComponentGraph::TarjanLeave(size_t i)
+{
   // Check if we have found a component.
   if (this->TarjanEntries[i].Root == i) {
     // Yes.  Create it.
@@ -101,8 +135,8 @@ void cmComputeComponentGraph::TarjanVisit(size_t i)
     size_t j;
     do {
       // Get the next member of the component.
-      j = this->TarjanStack.top();
-      this->TarjanStack.pop();
+      j = this->TarjanStack.back();
+      this->TarjanStack.pop_back();
 
       // Assign the member to the component.
       this->TarjanComponents[j] = c;
@@ -5,7 +5,6 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <cstddef>
-#include <stack>
 #include <vector>
 
 #include "cmGraphAdjacencyList.h"
@@ -18,7 +17,9 @@
  *
  * We use Tarjan's algorithm to enumerate the components efficiently.
  * An advantage of this approach is that the components are identified
- * in a topologically sorted order.
+ * in a topologically sorted order.  The depth-first search is driven
+ * by an explicit stack over a compact copy of the edge destinations, so
+ * large graphs neither exhaust the call stack nor chase edge objects.
  */
 class cmComputeComponentGraph
 {
@@ -68,15 +69,29 @@ private:
     size_t Root;
     size_t VisitIndex;
   };
+  struct TarjanFrame
+  {
+    size_t Node;
+    size_t Edge;
+  };
   std::vector<size_t> TarjanVisited;
   std::vector<size_t> TarjanComponents;
   std::vector<TarjanEntry> TarjanEntries;
   std::vector<NodeList> Components;
-  std::stack<size_t> TarjanStack;
+  std::vector<size_t> TarjanStack;
+  std::vector<TarjanFrame> TarjanFrames;
   size_t TarjanWalkId;
   size_t TarjanIndex;
   void Tarjan();
   void TarjanVisit(size_t i);
+  void TarjanEnter(size_t i);
+  void TarjanLeave(size_t i);
+
+  // Destinations of the input graph edges in compressed sparse row
+  // form: the edges of node i are EdgeTargets[EdgeOffsets[i]] up to
+  // EdgeTargets[EdgeOffsets[i + 1]].
+  std::vector<size_t> EdgeOffsets;
+  std::vector<size_t> EdgeTargets;
 
   // Connected components.
 };
@@ -18,9 +18,11 @@
 
 #include "cmCMakePath.h"
 #include "cmExpandedCommandArgument.h"
+#include "cmLinearRegularExpression.h"
 #include "cmList.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
+#include "cmRegularExpressionCache.h"
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -113,6 +115,17 @@ bool looksLikeSpecialVariable(std::string const& var,
   return ((prefix.size() + 3) <= varNameLen) &&
     cmHasPrefix(var, cmStrCat(prefix, '{')) && var[varNameLen - 1] == '}';
 }
+
+template <typename Regex>
+bool findAndStoreMatches(Regex& regex, std::string const& input,
+                         cmMakefile& makefile)
+{
+  bool const match = regex.find(input);
+  if (match) {
+    makefile.StoreMatches(regex);
+  }
+  return match;
+}
 } // anonymous namespace
 
 #if defined(__SUNPRO_CC)
@@ -561,8 +574,14 @@ bool cmConditionEvaluator::HandleLevel2(cmArgumentList& newArgs,
       this->Makefile.ClearMatches();
 
       auto const& rex = args.nextnext->GetValue();
-      cmsys::RegularExpression regEntry;
-      if (!regEntry.compile(rex)) {
+      cmsys::RegularExpression* regEntry = nullptr;
+      cmLinearRegularExpression* linearEntry = nullptr;
+      if (cmRegularExpressionCache::UseLinearEngine(this->Makefile)) {
+        linearEntry = cmRegularExpressionCache::GetLinear(rex);
+      } else {
+        regEntry = cmRegularExpressionCache::Get(rex);
+      }
+      if (!regEntry && !linearEntry) {
         std::ostringstream error;
         error << "Regular expression \"" << rex << "\" cannot compile";
         errorString = error.str();
@@ -570,10 +589,9 @@ bool cmConditionEvaluator::HandleLevel2(cmArgumentList& newArgs,
         return false;
       }
 
-      auto const match = regEntry.find(*def);
-      if (match) {
-        this->Makefile.StoreMatches(regEntry);
-      }
+      auto const match = linearEntry
+        ? findAndStoreMatches(*linearEntry, *def, this->Makefile)
+        : findAndStoreMatches(*regEntry, *def, this->Makefile);
       newArgs.ReduceTwoArgs(match, args);
     }
 
@@ -2,7 +2,9 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmCryptoHash.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
 
 #include <cm/memory>
 
@@ -11,6 +13,12 @@
 
 #include "cmsys/FStream.hxx"
 
+#if !defined(CMAKE_BOOTSTRAP)
+#  include <atomic>
+#  include <functional>
+#  include <thread>
+#endif
+
 static unsigned int const cmCryptoHashAlgoToId[] = {
   /* clang-format needs this comment to break after the opening brace */
   RHASH_MD5,      //
@@ -159,18 +167,20 @@ std::vector<unsigned char> cmCryptoHash::ByteHashFile(std::string const& file)
   if (fin) {
     this->Initialize();
     {
-      // Should be efficient enough on most system:
-      KWIML_INT_uint64_t buffer[512];
-      char* buffer_c = reinterpret_cast<char*>(buffer);
+      // Large blocks are read directly into the buffer, bypassing the
+      // stream's own buffer.
+      std::vector<KWIML_INT_uint64_t> buffer(8192);
+      char* buffer_c = reinterpret_cast<char*>(buffer.data());
       unsigned char const* buffer_uc =
-        reinterpret_cast<unsigned char const*>(buffer);
+        reinterpret_cast<unsigned char const*>(buffer.data());
       // This copy loop is very sensitive on certain platforms with
       // slightly broken stream libraries (like HPUX).  Normally, it is
       // incorrect to not check the error condition on the fin.read()
       // before using the data, but the fin.gcount() will be zero if an
       // error occurred.  Therefore, the loop should be safe everywhere.
       while (fin) {
-        fin.read(buffer_c, sizeof(buffer));
+        fin.read(buffer_c,
+                 buffer.size() * sizeof(KWIML_INT_uint64_t));
         if (int gcount = static_cast<int>(fin.gcount())) {
           this->Append(buffer_uc, gcount);
         }
@@ -197,6 +207,57 @@ std::string cmCryptoHash::HashFile(std::string const& file)
   return ByteHashToString(this->ByteHashFile(file));
 }
 
+std::vector<std::string> cmCryptoHash::HashFiles(
+  std::vector<std::string> const& files, unsigned int jobs)
+{
+  std::vector<std::string> hashes(files.size());
+#if !defined(CMAKE_BOOTSTRAP)
+  if (jobs == 0) {
+    jobs = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  if (jobs > files.size()) {
+    jobs = static_cast<unsigned int>(files.size());
+  }
+  if (jobs > 1) {
+    // The other hashers are created on this thread because the first
+    // one initializes the library.
+    std::size_t const algo =
+      std::find(std::begin(cmCryptoHashAlgoToId),
+                std::end(cmCryptoHashAlgoToId), this->Id) -
+      std::begin(cmCryptoHashAlgoToId);
+    std::vector<std::unique_ptr<cmCryptoHash>> hashers;
+    hashers.reserve(jobs - 1);
+    for (unsigned int j = 1; j < jobs; ++j) {
+      hashers.emplace_back(
+        cm::make_unique<cmCryptoHash>(static_cast<Algo>(algo)));
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto work = [&files, &hashes, &next](cmCryptoHash& hasher) {
+      for (std::size_t i = next++; i < files.size(); i = next++) {
+        hashes[i] = hasher.HashFile(files[i]);
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(hashers.size());
+    for (std::unique_ptr<cmCryptoHash>& hasher : hashers) {
+      workers.emplace_back(work, std::ref(*hasher));
+    }
+    work(*this);
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    return hashes;
+  }
+#else
+  static_cast<void>(jobs);
+#endif
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    hashes[i] = this->HashFile(files[i]);
+  }
+  return hashes;
+}
+
 void cmCryptoHash::Initialize()
 {
   rhash_reset(this->CTX);
@@ -74,6 +74,15 @@ public:
   ///         An empty string otherwise.
   std::string HashFile(std::string const& file);
 
+  /// @brief Calculates hash strings from the content of several files
+  /// @arg jobs Number of files read at the same time, or 0 to use one
+  ///      thread per processor
+  /// @see HashFile()
+  /// @return The hash string of each file, in order.  Empty for a file
+  ///         that could not be read.
+  std::vector<std::string> HashFiles(std::vector<std::string> const& files,
+                                     unsigned int jobs = 0);
+
   /// @brief Returns the name of the hash type.
   /// @return The name of the hash type associated with this hash generator.
   std::string GetHashAlgoName() const;
@@ -8,6 +8,78 @@
 
 #include <cm/string_view>
 
+cmListDefinition::cmListDefinition(std::string value)
+  : Value(std::move(value))
+{
+  this->Reindex();
+}
+
+void cmListDefinition::Append(cm::string_view elements)
+{
+  if (this->Value.empty()) {
+    this->Value.assign(elements.data(), elements.size());
+    this->Reindex();
+    return;
+  }
+  std::size_t const end = this->Value.size();
+  this->Value += ';';
+  this->Value.append(elements.data(), elements.size());
+  this->Index(end);
+}
+
+void cmListDefinition::Prepend(cm::string_view elements)
+{
+  if (!this->Value.empty()) {
+    this->Value.insert(0, 1, ';');
+  }
+  this->Value.insert(0, elements.data(), elements.size());
+  this->Reindex();
+}
+
+cm::string_view cmListDefinition::GetElement(std::size_t index) const
+{
+  assert(this->Indexed && index < this->Starts.size());
+  std::size_t const start = this->Starts[index];
+  std::size_t const end = index + 1 < this->Starts.size()
+    ? this->Starts[index + 1] - 1
+    : this->Value.size();
+  return cm::string_view(this->Value).substr(start, end - start);
+}
+
+void cmListDefinition::Reindex()
+{
+  this->Starts.clear();
+  if (this->Indexed && !this->Value.empty()) {
+    this->Starts.push_back(0);
+    this->Index(0);
+  }
+}
+
+void cmListDefinition::Index(std::size_t from)
+{
+  if (!this->Indexed) {
+    return;
+  }
+  for (std::size_t i = from; i < this->Value.size(); ++i) {
+    switch (this->Value[i]) {
+      case ';':
+        this->Starts.push_back(i + 1);
+        break;
+      case '[':
+      case ']':
+      case '\\':
+        // Semicolons may be escaped or nested in brackets.  Leave the
+        // splitting to cmList from now on.
+        this->Indexed = false;
+        this->Starts.clear();
+        this->Starts.shrink_to_fit();
+        return;
+      default:
+        break;
+    }
+  }
+}
+
 cmDefinitions::Def cmDefinitions::NoDef;
 
 cmDefinitions::Def const& cmDefinitions::GetInternal(std::string const& key,
@@ -37,7 +109,7 @@ cmValue cmDefinitions::Get(std::string const& key, StackIter begin,
                            StackIter end)
 {
   Def const& def = cmDefinitions::GetInternal(key, begin, end, false);
-  return def.Value ? cmValue(def.Value.str_if_stable()) : nullptr;
+  return def.IsSet() ? cmValue(def.Get()) : nullptr;
 }
 
 void cmDefinitions::Raise(std::string const& key, StackIter begin,
@@ -67,7 +139,7 @@ cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
       // Use this key if it is not already set or unset.
       if (closure.Map.find(mi.first) == closure.Map.end() &&
           undefined.find(mi.first.view()) == undefined.end()) {
-        if (mi.second.Value) {
+        if (mi.second.IsSet()) {
           closure.Map.insert(mi);
         } else {
           undefined.emplace(mi.first.view());
@@ -88,7 +160,7 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
     defined.reserve(defined.size() + it->Map.size());
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
-      if (bound.emplace(mi.first.view()).second && mi.second.Value) {
+      if (bound.emplace(mi.first.view()).second && mi.second.IsSet()) {
         defined.push_back(*mi.first.str_if_stable());
       }
     }
@@ -106,3 +178,49 @@ void cmDefinitions::Unset(std::string const& key)
 {
   this->Map[key] = Def();
 }
+
+cmListDefinition* cmDefinitions::GetLocalList(std::string const& key,
+                                              StackIter begin, StackIter end)
+{
+  if (!cmDefinitions::GetInternal(key, begin, end, false).IsSet()) {
+    return nullptr;
+  }
+  // Localize the definition so that other scopes keep their value.
+  cmDefinitions::Raise(key, begin, end);
+  Def& def = begin->Map.find(cm::String::borrow(key))->second;
+  if (!def.List) {
+    def.List = std::make_shared<cmListDefinition>(*def.Get());
+    def.Value = cm::String();
+  } else if (def.List.use_count() > 1) {
+    def.List = std::make_shared<cmListDefinition>(*def.List);
+  }
+  return def.List.get();
+}
+
+bool cmDefinitions::Append(std::string const& key, cm::string_view elements,
+                           StackIter begin, StackIter end)
+{
+  cmListDefinition* list = cmDefinitions::GetLocalList(key, begin, end);
+  if (!list) {
+    return false;
+  }
+  list->Append(elements);
+  return true;
+}
+
+bool cmDefinitions::Prepend(std::string const& key, cm::string_view elements,
+                            StackIter begin, StackIter end)
+{
+  cmListDefinition* list = cmDefinitions::GetLocalList(key, begin, end);
+  if (!list) {
+    return false;
+  }
+  list->Prepend(elements);
+  return true;
+}
+
+cmListDefinition const* cmDefinitions::GetList(std::string const& key,
+                                               StackIter begin, StackIter end)
+{
+  return cmDefinitions::GetInternal(key, begin, end, false).List.get();
+}
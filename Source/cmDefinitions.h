@@ -4,6 +4,8 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +16,49 @@
 #include "cmString.hxx"
 #include "cmValue.h"
 
+/** \class cmListDefinition
+ * \brief Value of a variable holding a list grown by list(APPEND).
+ *
+ * Appending to a plain value copies the whole list, so accumulating a
+ * list in a loop takes quadratic time.  This owns the joined value and
+ * grows it in place.  The start of each element is also recorded, as
+ * long as the value has no characters that change how it is split, so
+ * that the elements can be reached without parsing the value again.
+ */
+class cmListDefinition
+{
+public:
+  explicit cmListDefinition(std::string value);
+
+  std::string const& GetValue() const { return this->Value; }
+
+  /** Adds elements, separated by semicolons, at the end of the list.  */
+  void Append(cm::string_view elements);
+
+  /** Adds elements, separated by semicolons, at the start of the list.  */
+  void Prepend(cm::string_view elements);
+
+  /**
+   * Returns true if the elements are known.  This is false once the
+   * value contains square brackets or backslashes.
+   */
+  bool IsIndexed() const { return this->Indexed; }
+
+  /** Number of elements, including empty ones, when indexed.  */
+  std::size_t GetSize() const { return this->Starts.size(); }
+
+  /** Element of the list when indexed.  */
+  cm::string_view GetElement(std::size_t index) const;
+
+private:
+  void Reindex();
+  void Index(std::size_t from);
+
+  std::string Value;
+  std::vector<std::size_t> Starts;
+  bool Indexed = true;
+};
+
 /** \class cmDefinitions
  * \brief Store a scope of variable definitions for CMake language.
  *
@@ -46,6 +91,22 @@ public:
   /** Unset a definition.  */
   void Unset(std::string const& key);
 
+  /**
+   * Append list elements to the value of a key and store the result in
+   * the first scope.  The value is grown in place when the first scope
+   * owns it.  Returns false, without changes, if the key is not set.
+   */
+  static bool Append(std::string const& key, cm::string_view elements,
+                     StackIter begin, StackIter end);
+
+  /** Same as Append() but adds the elements at the start of the list.  */
+  static bool Prepend(std::string const& key, cm::string_view elements,
+                      StackIter begin, StackIter end);
+
+  /** Returns the value of a key if it was set by Append() or Prepend().  */
+  static cmListDefinition const* GetList(std::string const& key,
+                                         StackIter begin, StackIter end);
+
 private:
   /** String with existence boolean.  */
   struct Def
@@ -56,7 +117,16 @@ private:
       : Value(value)
     {
     }
+    bool IsSet() const { return this->Value || this->List; }
+    std::string const* Get() const
+    {
+      return this->List ? &this->List->GetValue()
+                        : this->Value.str_if_stable();
+    }
     cm::String Value;
+    // Replaces Value once the key is appended to.  Copies of the
+    // definition share it until one of them is appended to again.
+    std::shared_ptr<cmListDefinition> List;
   };
   static Def NoDef;
 
@@ -64,4 +134,7 @@ private:
 
   static Def const& GetInternal(std::string const& key, StackIter begin,
                                 StackIter end, bool raise);
+
+  static cmListDefinition* GetLocalList(std::string const& key,
+                                        StackIter begin, StackIter end);
 };
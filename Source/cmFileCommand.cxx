@@ -40,12 +40,14 @@
 #include "cmFileCopier.h"
 #include "cmFileInstaller.h"
 #include "cmFileLockPool.h"
+#include "cmFileMapping.h"
 #include "cmFileTimes.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
 #include "cmGlobCacheEntry.h"
 #include "cmGlobalGenerator.h"
 #include "cmHexFileConverter.h"
+#include "cmLinearRegularExpression.h"
 #include "cmList.h"
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
@@ -53,6 +55,8 @@
 #include "cmNewLineStyle.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
+#include "cmRecursiveGlob.h"
+#include "cmRegularExpressionCache.h"
 #include "cmRuntimeDependencyArchive.h"
 #include "cmState.h"
 #include "cmStringAlgorithms.h"
@@ -157,6 +161,57 @@ bool HandleAppendCommand(std::vector<std::string> const& args,
   return HandleWriteImpl(args, true, status);
 }
 
+// Files in the build tree may be rewritten while they are read, for
+// example by a build that runs at the same time.
+bool MayChangeWhileRead(cmMakefile const& mf, std::string const& fileName)
+{
+  return cmSystemTools::IsSubDirectory(fileName, mf.GetHomeOutputDirectory());
+}
+
+// Reads the part of a mapped file selected by file(READ) as the stream
+// in HandleReadCommand would.  A negative offset reads nothing.
+void ReadMappedContents(cm::string_view contents, long long offset,
+                        std::string::size_type sizeLimit, bool hex,
+                        std::string& output)
+{
+  if (offset < 0 ||
+      static_cast<unsigned long long>(offset) > contents.size()) {
+    return;
+  }
+  contents.remove_prefix(static_cast<std::size_t>(offset));
+
+  if (hex) {
+    static char const digits[] = "0123456789abcdef";
+    contents = contents.substr(0, sizeLimit);
+    output.reserve(2 * contents.size());
+    for (char c : contents) {
+      output += digits[(c >> 4) & 0xF];
+      output += digits[c & 0xF];
+    }
+    return;
+  }
+
+  while (sizeLimit > 0 && !contents.empty()) {
+    std::string::size_type const end = contents.find('\n');
+    bool const has_newline = end != cm::string_view::npos;
+    cm::string_view line = contents.substr(0, end);
+    contents.remove_prefix(has_newline ? end + 1 : contents.size());
+    // Avoid storing a carriage return character.
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    line = line.substr(0, sizeLimit);
+    sizeLimit = sizeLimit - line.size();
+    if (has_newline && sizeLimit > 0) {
+      sizeLimit--;
+    }
+    output.append(line.data(), line.size());
+    if (has_newline) {
+      output += "\n";
+    }
+  }
+}
+
 bool HandleReadCommand(std::vector<std::string> const& args,
                        cmExecutionStatus& status)
 {
@@ -190,23 +245,6 @@ bool HandleReadCommand(std::vector<std::string> const& args,
                         fileNameArg);
   }
 
-// Open the specified file.
-#if defined(_WIN32) || defined(__CYGWIN__)
-  cmsys::ifstream file(fileName.c_str(),
-                       arguments.Hex ? (std::ios::binary | std::ios::in)
-                                     : std::ios::in);
-#else
-  cmsys::ifstream file(fileName.c_str());
-#endif
-
-  if (!file) {
-    std::string error =
-      cmStrCat("failed to open for reading (",
-               cmSystemTools::GetLastSystemError(), "):\n  ", fileName);
-    status.SetError(error);
-    return false;
-  }
-
   // is there a limit?
   std::string::size_type sizeLimit = std::string::npos;
   if (!arguments.Limit.empty()) {
@@ -217,18 +255,47 @@ bool HandleReadCommand(std::vector<std::string> const& args,
   }
 
   // is there an offset?
-  cmsys::ifstream::off_type offset = 0;
+  long long offset = 0;
   if (!arguments.Offset.empty()) {
     long long off;
     if (cmStrToLongLong(arguments.Offset, &off)) {
-      offset = static_cast<cmsys::ifstream::off_type>(off);
+      offset = off;
     }
   }
 
-  file.seekg(offset, std::ios::beg); // explicit ios::beg for IBM VisualAge 6
-
   std::string output;
 
+  // Map the specified file if it cannot change while it is read.  Only
+  // the part that is used is read.
+  cmFileMapping mapping;
+  if (!MayChangeWhileRead(status.GetMakefile(), fileName) &&
+      mapping.Open(fileName)) {
+    ReadMappedContents(mapping.GetContents(), offset, sizeLimit,
+                       arguments.Hex, output);
+    status.GetMakefile().AddDefinition(variable, output);
+    return true;
+  }
+
+// Open the specified file.
+#if defined(_WIN32) || defined(__CYGWIN__)
+  cmsys::ifstream file(fileName.c_str(),
+                       arguments.Hex ? (std::ios::binary | std::ios::in)
+                                     : std::ios::in);
+#else
+  cmsys::ifstream file(fileName.c_str());
+#endif
+
+  if (!file) {
+    std::string error =
+      cmStrCat("failed to open for reading (",
+               cmSystemTools::GetLastSystemError(), "):\n  ", fileName);
+    status.SetError(error);
+    return false;
+  }
+
+  file.seekg(static_cast<cmsys::ifstream::off_type>(offset),
+             std::ios::beg); // explicit ios::beg for IBM VisualAge 6
+
   if (arguments.Hex) {
     // Convert part of the file into hex code
     char c;
@@ -258,10 +325,67 @@ bool HandleReadCommand(std::vector<std::string> const& args,
   return true;
 }
 
+#if !defined(CMAKE_BOOTSTRAP)
+bool HandleHashFilesCommand(std::vector<std::string> const& args,
+                            cmExecutionStatus& status)
+{
+  struct Arguments : public ArgumentParser::ParseResult
+  {
+    ArgumentParser::MaybeEmpty<std::vector<std::string>> Files;
+    std::string OutputVariable;
+  };
+
+  static auto const parser =
+    cmArgumentParser<Arguments>{}
+      .Bind("FILES"_s, &Arguments::Files)
+      .Bind("OUTPUT_VARIABLE"_s, &Arguments::OutputVariable);
+
+  std::vector<std::string> unparsedArguments;
+  Arguments const arguments =
+    parser.Parse(cmMakeRange(args).advance(1), &unparsedArguments);
+
+  if (arguments.MaybeReportError(status.GetMakefile())) {
+    return true;
+  }
+  if (!unparsedArguments.empty()) {
+    status.SetError(cmStrCat(args[0], " FILES given unknown argument \"",
+                             unparsedArguments.front(), "\"."));
+    return false;
+  }
+  if (arguments.OutputVariable.empty()) {
+    status.SetError(cmStrCat(args[0], " FILES requires OUTPUT_VARIABLE"));
+    return false;
+  }
+
+  std::unique_ptr<cmCryptoHash> hash(cmCryptoHash::New(args[0]));
+  if (!hash) {
+    return false;
+  }
+  std::vector<std::string> const hashes = hash->HashFiles(arguments.Files);
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    if (hashes[i].empty()) {
+      // Read the file again on this thread to get the reason it failed.
+      hash->HashFile(arguments.Files[i]);
+      status.SetError(cmStrCat(args[0], " failed to read file \"",
+                               arguments.Files[i],
+                               "\": ", cmSystemTools::GetLastSystemError()));
+      return false;
+    }
+  }
+  status.GetMakefile().AddDefinition(arguments.OutputVariable,
+                                     cmJoin(hashes, ";"));
+  return true;
+}
+#endif
+
 bool HandleHashCommand(std::vector<std::string> const& args,
                        cmExecutionStatus& status)
 {
 #if !defined(CMAKE_BOOTSTRAP)
+  if (args.size() > 3 && args[1] == "FILES") {
+    return HandleHashFilesCommand(args, status);
+  }
+
   if (args.size() != 3) {
     status.SetError(
       cmStrCat(args[0], " requires a file name and output variable"));
@@ -285,6 +409,138 @@ bool HandleHashCommand(std::vector<std::string> const& args,
 #endif
 }
 
+// Characters kept before the current position when file(STRINGS) reads
+// a block, so that those of a multi-byte character can be put back.
+std::size_t const StringsPutBackSize = 4;
+std::size_t const StringsBlockSize = 65536;
+
+// Reads the contents of a file for file(STRINGS) one character at a
+// time, as from a stream, or in runs of characters.  The contents are
+// either those of a whole mapped file, or read in blocks from a stream.
+class StringsReader
+{
+public:
+  explicit StringsReader(cm::string_view contents)
+    : Begin(contents.data())
+    , Pos(contents.data())
+    , End(contents.data() + contents.size())
+  {
+  }
+
+  explicit StringsReader(std::istream& stream)
+    : Stream(&stream)
+  {
+  }
+
+  StringsReader(StringsReader const&) = delete;
+  StringsReader& operator=(StringsReader const&) = delete;
+
+  int Get()
+  {
+    if (this->Pos == this->End && !this->Fill(1)) {
+      this->Good = false;
+      return EOF;
+    }
+    return static_cast<unsigned char>(*this->Pos++);
+  }
+
+  // Returns the last character read to the input.
+  void PutBack()
+  {
+    if (this->Good && this->Pos != this->Begin) {
+      --this->Pos;
+    }
+  }
+
+  // Reads up to max characters for which chars is true.  Stops early at
+  // the end of a block read from a stream.
+  cm::string_view ReadRun(bool const (&chars)[256], std::size_t max)
+  {
+    char const* const start = this->Pos;
+    char const* const end = start + std::min(max, this->Available());
+    while (this->Pos != end &&
+           chars[static_cast<unsigned char>(*this->Pos)]) {
+      ++this->Pos;
+    }
+    return cm::string_view(start, this->Pos - start);
+  }
+
+  std::size_t Tell() const
+  {
+    return this->Offset + static_cast<std::size_t>(this->Pos - this->Begin);
+  }
+
+  // The number of characters that can be read without reading a block.
+  std::size_t Available() const { return this->End - this->Pos; }
+
+  explicit operator bool() const { return this->Good; }
+
+  // Skips a byte order mark like cmsys::FStream::ReadBOM.
+  cmsys::FStream::BOM ReadBOM()
+  {
+    this->Fill(4);
+    auto const* bom = reinterpret_cast<unsigned char const*>(this->Pos);
+    std::size_t const n = this->Available();
+    if (n < 2) {
+      return cmsys::FStream::BOM_None;
+    }
+    if (bom[0] == 0xEF && bom[1] == 0xBB) {
+      if (n >= 3 && bom[2] == 0xBF) {
+        this->Pos += 3;
+        return cmsys::FStream::BOM_UTF8;
+      }
+    } else if (bom[0] == 0xFE && bom[1] == 0xFF) {
+      this->Pos += 2;
+      return cmsys::FStream::BOM_UTF16BE;
+    } else if (bom[0] == 0x00 && bom[1] == 0x00) {
+      if (n >= 4 && bom[2] == 0xFE && bom[3] == 0xFF) {
+        this->Pos += 4;
+        return cmsys::FStream::BOM_UTF32BE;
+      }
+    } else if (bom[0] == 0xFF && bom[1] == 0xFE) {
+      if (n >= 4 && bom[2] == 0x00 && bom[3] == 0x00) {
+        this->Pos += 4;
+        return cmsys::FStream::BOM_UTF32LE;
+      }
+      // The stream used to fail when the file ends here.
+      this->Good = n >= 4;
+      this->Pos += 2;
+      return cmsys::FStream::BOM_UTF16LE;
+    }
+    return cmsys::FStream::BOM_None;
+  }
+
+private:
+  // Reads blocks from the stream until at least n characters are
+  // available or the stream ends.  Returns false if none are available.
+  bool Fill(std::size_t n)
+  {
+    while (this->Stream && this->Available() < n && *this->Stream) {
+      std::size_t const read = this->Pos - this->Begin;
+      std::size_t const keep = std::min(read, StringsPutBackSize);
+      this->Offset += read - keep;
+      this->Buffer.erase(0, read - keep);
+      std::size_t const size = this->Buffer.size();
+      this->Buffer.resize(size + StringsBlockSize);
+      this->Stream->read(&this->Buffer[size], StringsBlockSize);
+      this->Buffer.resize(size +
+                          static_cast<std::size_t>(this->Stream->gcount()));
+      this->Begin = this->Buffer.data();
+      this->Pos = this->Begin + keep;
+      this->End = this->Begin + this->Buffer.size();
+    }
+    return this->Pos != this->End;
+  }
+
+  std::istream* Stream = nullptr;
+  std::string Buffer;
+  std::size_t Offset = 0;
+  char const* Begin = nullptr;
+  char const* Pos = nullptr;
+  char const* End = nullptr;
+  bool Good = true;
+};
+
 bool HandleStringsCommand(std::vector<std::string> const& args,
                           cmExecutionStatus& status)
 {
@@ -321,7 +577,11 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
   int limit_input = -1;
   int limit_output = -1;
   unsigned int limit_count = 0;
-  cmsys::RegularExpression regex;
+  // Without REGEX the matches of an unset expression are stored, which
+  // leaves them empty.
+  cmsys::RegularExpression no_regex;
+  cmsys::RegularExpression* regex = &no_regex;
+  cmLinearRegularExpression* linear_regex = nullptr;
   bool have_regex = false;
   bool store_regex = true;
   bool newline_consume = false;
@@ -402,7 +662,15 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
       maxlen = len;
       arg_mode = arg_none;
     } else if (arg_mode == arg_regex) {
-      if (!regex.compile(args[i])) {
+      bool compiled;
+      if (cmRegularExpressionCache::UseLinearEngine(status.GetMakefile())) {
+        linear_regex = cmRegularExpressionCache::GetLinear(args[i]);
+        compiled = linear_regex != nullptr;
+      } else {
+        regex = cmRegularExpressionCache::Get(args[i]);
+        compiled = regex != nullptr;
+      }
+      if (!compiled) {
         status.SetError(cmStrCat("STRINGS option REGEX value \"", args[i],
                                  "\" could not be compiled."));
         return false;
@@ -462,20 +730,27 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
     }
   }
 
-// Open the specified file.
-#if defined(_WIN32) || defined(__CYGWIN__)
-  cmsys::ifstream fin(fileName.c_str(), std::ios::in | std::ios::binary);
-#else
-  cmsys::ifstream fin(fileName.c_str());
-#endif
-  if (!fin) {
-    status.SetError(
-      cmStrCat("STRINGS file \"", fileName, "\" cannot be read."));
-    return false;
+  // Map the specified file if it cannot change while it is read, or
+  // else open it.
+  cmFileMapping mapping;
+  cmsys::ifstream stream;
+  bool const mapped = !MayChangeWhileRead(status.GetMakefile(), fileName) &&
+    mapping.Open(fileName);
+  if (!mapped) {
+    stream.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!stream) {
+      status.SetError(
+        cmStrCat("STRINGS file \"", fileName, "\" cannot be read."));
+      return false;
+    }
   }
+  std::unique_ptr<StringsReader> const reader = mapped
+    ? cm::make_unique<StringsReader>(mapping.GetContents())
+    : cm::make_unique<StringsReader>(stream);
+  StringsReader& fin = *reader;
 
   // If BOM is found and encoding was not specified, use the BOM
-  int bom_found = cmsys::FStream::ReadBOM(fin);
+  int bom_found = fin.ReadBOM();
   if (encoding == encoding_none && bom_found != cmsys::FStream::BOM_None) {
     encoding = bom_found;
   }
@@ -488,20 +763,59 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
     bytes_rem = 3;
   }
 
+  // Characters that may be part of a string.
+  bool string_chars[256];
+  for (int c = 0; c < 256; ++c) {
+    string_chars[c] =
+      isprint(c) || c == '\t' || (c == '\n' && newline_consume);
+  }
+
   // Parse strings out of the file.
   int output_size = 0;
   std::vector<std::string> strings;
   std::string s;
+
+  auto regex_find = [&](std::string const& str) -> bool {
+    return linear_regex ? linear_regex->find(str) : regex->find(str);
+  };
+
+  auto store_matches = [&]() {
+    status.GetMakefile().ClearMatches();
+    if (linear_regex) {
+      status.GetMakefile().StoreMatches(*linear_regex);
+    } else {
+      status.GetMakefile().StoreMatches(*regex);
+    }
+  };
+
   while ((!limit_count || strings.size() < limit_count) &&
-         (limit_input < 0 || static_cast<int>(fin.tellg()) < limit_input) &&
+         (limit_input < 0 ||
+          fin.Tell() < static_cast<std::size_t>(limit_input)) &&
          fin) {
+    if (bytes_rem == 0) {
+      // Append the characters that only extend the current string at
+      // once.  The last one allowed is left to the checks below.
+      std::size_t run = fin.Available();
+      if (limit_input >= 0) {
+        run =
+          std::min(run, static_cast<std::size_t>(limit_input) - fin.Tell());
+      }
+      if (maxlen > 0) {
+        run = s.size() < maxlen ? std::min<std::size_t>(run, maxlen - s.size())
+                                : 0;
+      }
+      if (run > 1) {
+        cm::string_view const chars = fin.ReadRun(string_chars, run - 1);
+        s.append(chars.data(), chars.size());
+      }
+    }
+
     std::string current_str;
 
-    int c = fin.get();
+    int c = fin.Get();
     for (unsigned int i = 0; i < bytes_rem; ++i) {
-      int c1 = fin.get();
+      int c1 = fin.Get();
       if (!fin) {
-        fin.putback(static_cast<char>(c1));
         break;
       }
       c = (c << 8) | c1;
@@ -518,8 +832,7 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
       continue;
     }
 
-    if (c >= 0 && c <= 0xFF &&
-        (isprint(c) || c == '\t' || (c == '\n' && newline_consume))) {
+    if (c >= 0 && c <= 0xFF && string_chars[c]) {
       // This is an ASCII character that may be part of a string.
       // Cast added to avoid compiler warning. Cast is ok because
       // c is guaranteed to fit in char by the above if...
@@ -543,9 +856,9 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
       // get subsequent octets and check that they are valid
       for (unsigned int j = 0; j < num_utf8_bytes; j++) {
         if (j != 0) {
-          c = fin.get();
+          c = fin.Get();
           if (!fin || (c & 0xC0) != 0x80) {
-            fin.putback(static_cast<char>(c));
+            fin.PutBack();
             break;
           }
         }
@@ -556,7 +869,7 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
       // back subsequent characters
       if ((current_str.length() != num_utf8_bytes)) {
         for (unsigned int j = 0; j < current_str.size() - 1; j++) {
-          fin.putback(current_str[current_str.size() - 1 - j]);
+          fin.PutBack();
         }
         current_str.clear();
       }
@@ -566,10 +879,9 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
       // The current line has been terminated.  Check if the current
       // string matches the requirements.  The length may now be as
       // low as zero since blank lines are allowed.
-      if (s.length() >= minlen && (!have_regex || regex.find(s))) {
+      if (s.length() >= minlen && (!have_regex || regex_find(s))) {
         if (store_regex) {
-          status.GetMakefile().ClearMatches();
-          status.GetMakefile().StoreMatches(regex);
+          store_matches();
         }
         output_size += static_cast<int>(s.size()) + 1;
         if (limit_output >= 0 && output_size >= limit_output) {
@@ -586,10 +898,9 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
       // string matches the requirements.  We require that the length
       // be at least one no matter what the user specified.
       if (s.length() >= minlen && !s.empty() &&
-          (!have_regex || regex.find(s))) {
+          (!have_regex || regex_find(s))) {
         if (store_regex) {
-          status.GetMakefile().ClearMatches();
-          status.GetMakefile().StoreMatches(regex);
+          store_matches();
         }
         output_size += static_cast<int>(s.size()) + 1;
         if (limit_output >= 0 && output_size >= limit_output) {
@@ -607,10 +918,9 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
 
     if (maxlen > 0 && s.size() == maxlen) {
       // Terminate a string if the maximum length is reached.
-      if (s.length() >= minlen && (!have_regex || regex.find(s))) {
+      if (s.length() >= minlen && (!have_regex || regex_find(s))) {
         if (store_regex) {
-          status.GetMakefile().ClearMatches();
-          status.GetMakefile().StoreMatches(regex);
+          store_matches();
         }
         output_size += static_cast<int>(s.size()) + 1;
         if (limit_output >= 0 && output_size >= limit_output) {
@@ -627,10 +937,9 @@ bool HandleStringsCommand(std::vector<std::string> const& args,
   // input file or the input size limit.  Check if the current string
   // matches the requirements.
   if ((!limit_count || strings.size() < limit_count) && !s.empty() &&
-      s.length() >= minlen && (!have_regex || regex.find(s))) {
+      s.length() >= minlen && (!have_regex || regex_find(s))) {
     if (store_regex) {
-      status.GetMakefile().ClearMatches();
-      status.GetMakefile().StoreMatches(regex);
+      store_matches();
     }
     output_size += static_cast<int>(s.size()) + 1;
     if (limit_output < 0 || output_size < limit_output) {
@@ -762,8 +1071,17 @@ bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
         }
       }
 
+      // Recursive globs that do not follow symlinks have a faster
+      // implementation for the expressions it supports.
       cmsys::Glob::GlobMessages globMessages;
-      g.FindFiles(expr, &globMessages);
+      cmRecursiveGlob rg;
+      rg.SetListDirectories(g.GetRecurseListDirs());
+      rg.SetRelative(g.GetRelative() ? g.GetRelative() : "");
+      bool const walked = recurse && !g.GetRecurseThroughSymlinks() &&
+        rg.FindFiles(expr, &globMessages);
+      if (!walked) {
+        g.FindFiles(expr, &globMessages);
+      }
 
       if (!globMessages.empty()) {
         bool shouldExit = false;
@@ -791,7 +1109,8 @@ bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
         }
       }
 
-      std::vector<std::string>& foundFiles = g.GetFiles();
+      std::vector<std::string>& foundFiles =
+        walked ? rg.GetFiles() : g.GetFiles();
       cm::append(files, foundFiles);
 
       if (configureDepends) {
@@ -806,6 +1125,9 @@ bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
           expr,
           foundFiles
         };
+        if (walked) {
+          entry.Directories = std::move(rg.GetDirectories());
+        }
         cm->AddGlobCacheEntry(entry, variable,
                               status.GetMakefile().GetBacktrace());
       } else {
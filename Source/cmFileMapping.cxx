@@ -0,0 +1,60 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmFileMapping.h"
+
+#if !defined(_WIN32)
+#  include <cstdint>
+
+#  include <fcntl.h>
+#  include <unistd.h>
+
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+cmFileMapping::~cmFileMapping()
+{
+  this->Close();
+}
+
+bool cmFileMapping::Open(std::string const& fileName)
+{
+  this->Close();
+#if defined(_WIN32)
+  static_cast<void>(fileName);
+  return false;
+#else
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  // Files of unknown size, such as pipes, devices and those in /proc,
+  // cannot be mapped.
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+      static_cast<std::uintmax_t>(st.st_size) <= SIZE_MAX) {
+    std::size_t const size = static_cast<std::size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED) {
+      this->Mapping = mapping;
+      this->Data = static_cast<char const*>(mapping);
+      this->Size = size;
+    }
+  }
+  close(fd);
+  return this->Mapping != nullptr;
+#endif
+}
+
+void cmFileMapping::Close()
+{
+#if !defined(_WIN32)
+  if (this->Mapping) {
+    munmap(this->Mapping, this->Size);
+  }
+#endif
+  this->Mapping = nullptr;
+  this->Data = nullptr;
+  this->Size = 0;
+}
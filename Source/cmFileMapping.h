@@ -0,0 +1,46 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <string>
+
+#include <cm/string_view>
+
+/** \class cmFileMapping
+ * \brief Read-only memory mapping of the contents of a file.
+ *
+ * Only the pages that are used are ever read from disk.  Reading a mapped
+ * page past the end of a file that was truncated after it was mapped
+ * raises SIGBUS instead of reporting an error, so files that may change
+ * while they are open must be read as streams instead.
+ */
+class cmFileMapping
+{
+public:
+  cmFileMapping() = default;
+  ~cmFileMapping();
+  cmFileMapping(cmFileMapping const&) = delete;
+  cmFileMapping& operator=(cmFileMapping const&) = delete;
+
+  /**
+   * Maps the file.  Returns false if it cannot be mapped, for example
+   * because it is not a regular file, is empty, or the platform is not
+   * supported.  The file should then be read as a stream.
+   */
+  bool Open(std::string const& fileName);
+
+  void Close();
+
+  cm::string_view GetContents() const
+  {
+    return cm::string_view(this->Data, this->Size);
+  }
+
+private:
+  char const* Data = nullptr;
+  std::size_t Size = 0;
+  void* Mapping = nullptr;
+};
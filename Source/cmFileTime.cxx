@@ -2,6 +2,7 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmFileTime.h"
 
+#include <chrono>
 #include <string>
 
 // Use a platform-specific API to get file times efficiently.
@@ -48,3 +49,23 @@ bool cmFileTime::Load(std::string const& fileName)
 #endif
   return true;
 }
+
+cmFileTime cmFileTime::Now()
+{
+  cmFileTime now;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  // File times count from the same epoch as the system clock.
+  now.Time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+               .count();
+#else
+  FILETIME ftime;
+  GetSystemTimeAsFileTime(&ftime);
+
+  using uint64 = unsigned long long;
+
+  now.Time = static_cast<TimeType>((uint64(ftime.dwHighDateTime) << 32) +
+                                   ftime.dwLowDateTime);
+#endif
+  return now;
+}
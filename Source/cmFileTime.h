@@ -33,6 +33,11 @@ public:
    */
   bool Load(std::string const& fileName);
 
+  /**
+   * @brief Returns the current time of the system clock as a file time
+   */
+  static cmFileTime Now();
+
   /**
    * @brief Return true if this is older than ftm
    */
@@ -136,6 +141,11 @@ public:
    */
   TimeType GetTime() const { return this->Time; }
 
+  /**
+   * @brief Sets the time to one saved from GetTime()
+   */
+  void SetTime(TimeType time) { this->Time = time; }
+
 private:
   TimeType Time = 0;
 };
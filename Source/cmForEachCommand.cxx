@@ -20,6 +20,7 @@
 #include <cm/string_view>
 #include <cmext/string_view>
 
+#include "cmDefinitions.h"
 #include "cmExecutionStatus.h"
 #include "cmFunctionBlocker.h"
 #include "cmList.h"
@@ -347,6 +348,12 @@ bool HandleInMode(std::vector<std::string> const& args,
       fb->SetZipLists();
 
     } else if (doing == DoingLists) {
+      if (cmListDefinition const* indexed = makefile.GetListDefinition(arg)) {
+        for (std::size_t i = 0; i < indexed->GetSize(); ++i) {
+          fb->Args.emplace_back(indexed->GetElement(i));
+        }
+        continue;
+      }
       auto const& value = makefile.GetSafeDefinition(arg);
       if (!value.empty()) {
         cmExpandList(value, fb->Args, cmList::EmptyElements::Yes);
@@ -351,6 +351,15 @@ cmComputeLinkInformation* cmGeneratorTarget::GetLinkInformation(
   std::string key(cmSystemTools::UpperCase(config));
   auto i = this->LinkInformation.find(key);
   if (i == this->LinkInformation.end()) {
+#if !defined(CMAKE_BOOTSTRAP)
+    auto profilingRAII =
+      this->GetLocalGenerator()->GetCMakeInstance()->CreateProfilingEntry(
+        "link_compute", this->GetName(), [&config]() -> Json::Value {
+          Json::Value args = Json::objectValue;
+          args["config"] = config;
+          return args;
+        });
+#endif
     // Compute information for this configuration.
     auto info = cm::make_unique<cmComputeLinkInformation>(this, config);
     if (info && !info->Compute()) {
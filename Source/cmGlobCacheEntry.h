@@ -5,8 +5,21 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "cmFileTime.h"
+
+// A directory listed by a glob.  A new glob can only find different files
+// if its modification time changed, or if it was modified so shortly
+// before it was listed that a later change may have kept the same time.
+struct cmGlobDirectory
+{
+  std::string Path;
+  cmFileTime Modified;
+  cmFileTime Listed;
+};
+
 struct cmGlobCacheEntry
 {
   bool const Recurse;
@@ -15,6 +28,8 @@ struct cmGlobCacheEntry
   std::string const Relative;
   std::string const Expression;
   std::vector<std::string> Files;
+  // Directories listed by the glob, if the glob recorded them.
+  std::vector<cmGlobDirectory> Directories;
 
   cmGlobCacheEntry(bool recurse, bool listDirectories, bool followSymlinks,
                    std::string relative, std::string expression,
@@ -2,19 +2,109 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmGlobVerificationManager.h"
 
+#include <algorithm>
+#include <iostream>
 #include <sstream>
 
+#include <cm/string_view>
+#include <cmext/string_view>
+
 #include "cmsys/FStream.hxx"
+#include "cmsys/Glob.hxx"
 
 #include "cmGeneratedFileStream.h"
 #include "cmGlobCacheEntry.h"
 #include "cmListFileCache.h"
 #include "cmMessageType.h"
 #include "cmMessenger.h"
+#include "cmRecursiveGlob.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmVersion.h"
 
+namespace {
+// Directories modified less than this long before they were listed may
+// have changed again within the resolution of the file system.
+cmFileTime::TimeType const cmGlobVerifyRacyTime = 2 * cmFileTime::UtPerS;
+
+/* The data file holds one line per item:
+
+     stamp <path>
+     relative <path>        (for the next glob only)
+     glob <recurse> <list-directories> <follow-symlinks> <expression>
+     file <path>            (found by the last glob)
+     directory <modified> <listed> <path>  (listed by the last glob)
+*/
+void WriteVerifyData(std::ostream& out, std::string const& stamp,
+                     std::vector<cmGlobCacheEntry> const& entries)
+{
+  out << "# CMAKE generated file: DO NOT EDIT!\n"
+      << "stamp " << stamp << '\n';
+  for (cmGlobCacheEntry const& entry : entries) {
+    if (!entry.Relative.empty()) {
+      out << "relative " << entry.Relative << '\n';
+    }
+    out << "glob " << entry.Recurse << ' ' << entry.ListDirectories << ' '
+        << entry.FollowSymlinks << ' ' << entry.Expression << '\n';
+    for (std::string const& file : entry.Files) {
+      out << "file " << file << '\n';
+    }
+    for (cmGlobDirectory const& dir : entry.Directories) {
+      out << "directory " << dir.Modified.GetTime() << ' '
+          << dir.Listed.GetTime() << ' ' << dir.Path << '\n';
+    }
+  }
+}
+
+// Finds the files of a glob the same way file(GLOB) does, and reports
+// its messages as file(GLOB) does in the verification script.
+bool RunGlob(cmGlobCacheEntry& entry)
+{
+  entry.Directories.clear();
+  cmsys::Glob::GlobMessages messages;
+  cmRecursiveGlob rg;
+  rg.SetListDirectories(entry.ListDirectories);
+  rg.SetRelative(entry.Relative);
+  if (entry.Recurse && !entry.FollowSymlinks &&
+      rg.FindFiles(entry.Expression, &messages)) {
+    entry.Files = std::move(rg.GetFiles());
+    entry.Directories = std::move(rg.GetDirectories());
+  } else {
+    cmsys::Glob g;
+    g.SetRecurse(entry.Recurse);
+    g.SetRecurseThroughSymlinks(entry.FollowSymlinks);
+    g.SetListDirs(entry.ListDirectories);
+    g.SetRecurseListDirs(entry.ListDirectories);
+    if (!entry.Relative.empty()) {
+      g.SetRelative(entry.Relative.c_str());
+    }
+    g.FindFiles(entry.Expression, &messages);
+    entry.Files = std::move(g.GetFiles());
+  }
+  bool success = true;
+  for (cmsys::Glob::Message const& message : messages) {
+    if (message.type == cmsys::Glob::cyclicRecursion) {
+      cmSystemTools::Message(
+        cmStrCat("Cyclic recursion detected while globbing for '",
+                 entry.Expression, "':\n", message.content),
+        "Warning");
+    } else if (message.type == cmsys::Glob::error) {
+      cmSystemTools::Error(cmStrCat("Error has occurred while globbing for '",
+                                    entry.Expression, "' - ",
+                                    message.content));
+      success = false;
+    }
+  }
+  if (!success) {
+    return false;
+  }
+  std::sort(entry.Files.begin(), entry.Files.end());
+  entry.Files.erase(std::unique(entry.Files.begin(), entry.Files.end()),
+                    entry.Files.end());
+  return true;
+}
+}
+
 bool cmGlobVerificationManager::SaveVerificationScript(std::string const& path,
                                                        cmMessenger* messenger)
 {
@@ -24,8 +114,10 @@ bool cmGlobVerificationManager::SaveVerificationScript(std::string const& path,
 
   std::string scriptFile = cmStrCat(path, "/CMakeFiles");
   std::string stampFile = scriptFile;
+  std::string dataFile = scriptFile;
   cmSystemTools::MakeDirectory(scriptFile);
   scriptFile += "/VerifyGlobs.cmake";
+  dataFile += "/VerifyGlobs.txt";
   stampFile += "/cmake.verify_globs";
   cmGeneratedFileStream verifyScriptFile(scriptFile);
   verifyScriptFile.SetCopyIfDifferent(true);
@@ -74,6 +166,18 @@ bool cmGlobVerificationManager::SaveVerificationScript(std::string const& path,
   }
   verifyScriptFile.Close();
 
+  // The data file is rewritten by verification runs, so it is not
+  // compared with its previous content.
+  cmGeneratedFileStream verifyDataFile(dataFile);
+  if (!verifyDataFile) {
+    cmSystemTools::Error("Unable to open verification data file for save. " +
+                         dataFile);
+    cmSystemTools::ReportLastSystemError("");
+    return false;
+  }
+  WriteVerifyData(verifyDataFile, stampFile, this->GetCacheEntries());
+  verifyDataFile.Close();
+
   cmsys::ofstream verifyStampFile(stampFile.c_str());
   if (!verifyStampFile) {
     cmSystemTools::Error("Unable to open verification stamp file for write. " +
@@ -83,10 +187,105 @@ bool cmGlobVerificationManager::SaveVerificationScript(std::string const& path,
   verifyStampFile << "# This file is generated by CMake for checking of the "
                      "VerifyGlobs.cmake file\n";
   this->VerifyScript = scriptFile;
+  this->VerifyData = dataFile;
   this->VerifyStamp = stampFile;
   return true;
 }
 
+bool cmGlobVerificationManager::VerifyGlobs(std::string const& dataFile)
+{
+  cmsys::ifstream fin(dataFile.c_str());
+  if (!fin) {
+    cmSystemTools::Error("Unable to read verification data file " +
+                         dataFile);
+    return false;
+  }
+
+  // Read the globs with the directory times saved for them.
+  std::string stampFile;
+  std::string relative;
+  std::vector<cmGlobCacheEntry> entries;
+  std::vector<std::vector<std::string>> savedDirectories;
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    std::string::size_type const space = line.find(' ');
+    if (space == std::string::npos || line[0] == '#') {
+      continue;
+    }
+    cm::string_view const key(line.data(), space);
+    std::string value = line.substr(space + 1);
+    if (key == "stamp"_s) {
+      stampFile = std::move(value);
+    } else if (key == "relative"_s) {
+      relative = std::move(value);
+    } else if (key == "glob"_s && value.size() > 6) {
+      entries.emplace_back(value[0] == '1', value[2] == '1', value[4] == '1',
+                           std::move(relative), value.substr(6),
+                           std::vector<std::string>());
+      savedDirectories.emplace_back();
+      relative.clear();
+    } else if (entries.empty()) {
+      continue;
+    } else if (key == "file"_s) {
+      entries.back().Files.push_back(std::move(value));
+    } else if (key == "directory"_s) {
+      savedDirectories.back().push_back(std::move(value));
+    }
+  }
+  fin.close();
+
+  bool refreshed = false;
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    cmGlobCacheEntry& entry = entries[i];
+
+    // Globs that saved no directories are always repeated.  So are those
+    // with a directory modified too shortly before it was listed to tell
+    // whether it changed again.
+    bool unchanged = !savedDirectories[i].empty();
+    for (std::string const& saved : savedDirectories[i]) {
+      std::string::size_type const listedStart = saved.find(' ') + 1;
+      std::string::size_type const pathStart = saved.find(' ', listedStart);
+      long long modified;
+      long long listed;
+      cmGlobDirectory dir;
+      if (listedStart == 0 || pathStart == std::string::npos ||
+          !cmStrToLongLong(saved.substr(0, listedStart - 1), &modified) ||
+          !cmStrToLongLong(
+            saved.substr(listedStart, pathStart - listedStart), &listed)) {
+        unchanged = false;
+        break;
+      }
+      dir.Path = saved.substr(pathStart + 1);
+      if (!dir.Modified.Load(dir.Path) ||
+          dir.Modified.GetTime() != modified ||
+          listed - modified < cmGlobVerifyRacyTime) {
+        unchanged = false;
+        break;
+      }
+      dir.Listed.SetTime(listed);
+      entry.Directories.push_back(std::move(dir));
+    }
+    if (unchanged) {
+      continue;
+    }
+
+    std::vector<std::string> const savedFiles = entry.Files;
+    if (!RunGlob(entry) || entry.Files != savedFiles) {
+      std::cerr << "-- GLOB mismatch!\n";
+      cmSystemTools::Touch(stampFile, false);
+      return true;
+    }
+    refreshed = true;
+  }
+
+  // Save the new directory times so the next run can trust them.
+  if (refreshed) {
+    cmGeneratedFileStream fout(dataFile);
+    WriteVerifyData(fout, stampFile, entries);
+  }
+  return true;
+}
+
 bool cmGlobVerificationManager::DoWriteVerifyTarget() const
 {
   return !this->VerifyScript.empty() && !this->VerifyStamp.empty();
@@ -153,6 +352,7 @@ void cmGlobVerificationManager::AddCacheEntry(
   CacheEntryValue& value = this->Cache[key];
   if (!value.Initialized) {
     value.Files = entry.Files;
+    value.Directories = entry.Directories;
     value.Initialized = true;
     value.Backtraces.emplace_back(variable, backtrace);
   } else if (value.Initialized && value.Files != entry.Files) {
@@ -184,6 +384,7 @@ std::vector<cmGlobCacheEntry> cmGlobVerificationManager::GetCacheEntries()
     if (v.Initialized) {
       entries.emplace_back(k.Recurse, k.ListDirectories, k.FollowSymlinks,
                            k.Relative, k.Expression, v.Files);
+      entries.back().Directories = v.Directories;
     }
   }
   return entries;
@@ -193,5 +394,6 @@ void cmGlobVerificationManager::Reset()
 {
   this->Cache.clear();
   this->VerifyScript.clear();
+  this->VerifyData.clear();
   this->VerifyStamp.clear();
 }
@@ -10,22 +10,33 @@
 #include <utility>
 #include <vector>
 
+#include "cmGlobCacheEntry.h"
 #include "cmListFileCache.h"
 
 class cmMessenger;
-struct cmGlobCacheEntry;
 
 /** \class cmGlobVerificationManager
  * \brief Class for expressing build-time dependencies on glob expressions.
  *
  * Generates a CMake script which verifies glob outputs during prebuild.
- *
+ * The same globs are also saved in a form read by
+ * 'cmake -E cmake_verify_globs', which repeats only those whose
+ * directories changed since they were last run.
  */
 class cmGlobVerificationManager
 {
+public:
+  /**
+   * Repeats the globs saved in the given file whose directories changed.
+   * Touches the stamp file if one finds different files.  Returns false
+   * if the file cannot be read.
+   */
+  static bool VerifyGlobs(std::string const& dataFile);
+
 protected:
   //! Save verification script for given makefile.
   //! Saves to output <path>/<CMakeFilesDirectory>/VerifyGlobs.cmake
+  //! and <path>/<CMakeFilesDirectory>/VerifyGlobs.txt
   bool SaveVerificationScript(std::string const& path, cmMessenger* messenger);
 
   //! Add an entry into the glob cache
@@ -42,8 +53,9 @@ protected:
   //! Check targets should be written in generated build system.
   bool DoWriteVerifyTarget() const;
 
-  //! Get the paths to the generated script and stamp files
+  //! Get the paths to the generated script, data and stamp files
   std::string const& GetVerifyScript() const { return this->VerifyScript; }
+  std::string const& GetVerifyData() const { return this->VerifyData; }
   std::string const& GetVerifyStamp() const { return this->VerifyStamp; }
 
 private:
@@ -71,12 +83,14 @@ private:
   {
     bool Initialized = false;
     std::vector<std::string> Files;
+    std::vector<cmGlobDirectory> Directories;
     std::vector<std::pair<std::string, cmListFileBacktrace>> Backtraces;
   };
 
   using CacheEntryMap = std::map<CacheEntryKey, CacheEntryValue>;
   CacheEntryMap Cache;
   std::string VerifyScript;
+  std::string VerifyData;
   std::string VerifyStamp;
 
   // Only cmState should be able to add cache values.
@@ -1446,6 +1446,11 @@ bool cmGlobalGenerator::UnsupportedVariableIsDefined(std::string const& name,
 
 bool cmGlobalGenerator::Compute()
 {
+#if !defined(CMAKE_BOOTSTRAP)
+  auto profilingRAII =
+    this->CMakeInstance->CreateProfilingEntry("generate", "compute");
+#endif
+
   // Make sure unsupported variables are not used.
   if (this->UnsupportedVariableIsDefined("CMAKE_DEFAULT_BUILD_TYPE",
                                          this->SupportsDefaultBuildType())) {
@@ -1572,6 +1577,10 @@ bool cmGlobalGenerator::Compute()
   // Trace the dependencies, after that no custom commands should be added
   // because their dependencies might not be handled correctly
   for (auto const& localGen : this->LocalGenerators) {
+#if !defined(CMAKE_BOOTSTRAP)
+    auto traceProfilingRAII = this->CMakeInstance->CreateProfilingEntry(
+      "trace_dependencies", localGen->GetCurrentBinaryDirectory());
+#endif
     localGen->TraceDependencies();
   }
 
@@ -1588,10 +1597,16 @@ bool cmGlobalGenerator::Compute()
   }
 
   // Compute the inter-target dependencies.
-  if (!this->ComputeTargetDepends()) {
-    return false;
+  {
+#if !defined(CMAKE_BOOTSTRAP)
+    auto dependsProfilingRAII = this->CMakeInstance->CreateProfilingEntry(
+      "generate", "target_depends");
+#endif
+    if (!this->ComputeTargetDepends()) {
+      return false;
+    }
+    this->ComputeTargetOrder();
   }
-  this->ComputeTargetOrder();
 
   if (this->CheckTargetsForType()) {
     return false;
@@ -1610,6 +1625,11 @@ bool cmGlobalGenerator::Compute()
 
 void cmGlobalGenerator::Generate()
 {
+#if !defined(CMAKE_BOOTSTRAP)
+  auto profilingRAII =
+    this->CMakeInstance->CreateProfilingEntry("generate", "generate");
+#endif
+
   // Create a map from local generator to the complete set of targets
   // it builds by default.
   this->InitializeProgressMarks();
@@ -1631,6 +1651,11 @@ void cmGlobalGenerator::Generate()
 
   // Generate project files
   for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i) {
+#if !defined(CMAKE_BOOTSTRAP)
+    auto dirProfilingRAII = this->CMakeInstance->CreateProfilingEntry(
+      "generate_directory",
+      this->LocalGenerators[i]->GetCurrentBinaryDirectory());
+#endif
     this->SetCurrentMakefile(this->LocalGenerators[i]->GetMakefile());
     this->LocalGenerators[i]->Generate();
     if (!this->LocalGenerators[i]->GetMakefile()->IsOn(
@@ -3504,26 +3529,52 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
   if (needDisk) {
     long mt = cmSystemTools::ModifiedTime(dir);
     if (mt != dc.LastDiskTime) {
-      // Reset to non-loaded directory content.
-      dc.All = dc.Generated;
-
-      // Load the directory content from disk.
-      cmsys::Directory d;
-      if (d.Load(dir)) {
-        unsigned long n = d.GetNumberOfFiles();
-        for (unsigned long i = 0; i < n; ++i) {
-          char const* f = d.GetFile(i);
-          if (strcmp(f, ".") != 0 && strcmp(f, "..") != 0) {
-            dc.All.insert(f);
-          }
-        }
-      }
+      this->LoadDirectoryContent(dir, dc);
+      dc.LastDiskTime = mt;
+    }
+  }
+  return dc.All;
+}
+
+std::set<std::string> const& cmGlobalGenerator::GetLinkDirectoryContent(
+  std::string const& dir)
+{
+  DirectoryContent& dc = this->DirectoryContentMap[dir];
+  if (!dc.LoadedForGenerate) {
+    dc.LoadedForGenerate = true;
+    long mt = cmSystemTools::ModifiedTime(dir);
+    if (mt != dc.LastDiskTime) {
+      this->LoadDirectoryContent(dir, dc);
       dc.LastDiskTime = mt;
     }
   }
   return dc.All;
 }
 
+void cmGlobalGenerator::LoadDirectoryContent(std::string const& dir,
+                                             DirectoryContent& dc)
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  auto profilingRAII =
+    this->CMakeInstance->CreateProfilingEntry("filesystem_list", dir);
+#endif
+
+  // Reset to non-loaded directory content.
+  dc.All = dc.Generated;
+
+  // Load the directory content from disk.
+  cmsys::Directory d;
+  if (d.Load(dir)) {
+    unsigned long n = d.GetNumberOfFiles();
+    for (unsigned long i = 0; i < n; ++i) {
+      char const* f = d.GetFile(i);
+      if (strcmp(f, ".") != 0 && strcmp(f, "..") != 0) {
+        dc.All.insert(f);
+      }
+    }
+  }
+}
+
 void cmGlobalGenerator::AddRuleHash(std::vector<std::string> const& outputs,
                                     std::string const& content)
 {
@@ -3782,6 +3833,10 @@ std::string const& cmGlobalGenerator::GetRealPath(std::string const& dir)
   auto i = this->RealPaths.lower_bound(dir);
   if (i == this->RealPaths.end() ||
       this->RealPaths.key_comp()(dir, i->first)) {
+#if !defined(CMAKE_BOOTSTRAP)
+    auto profilingRAII =
+      this->CMakeInstance->CreateProfilingEntry("filesystem_realpath", dir);
+#endif
     i = this->RealPaths.emplace_hint(i, dir, cmSystemTools::GetRealPath(dir));
   }
   return i->second;
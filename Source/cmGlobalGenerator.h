@@ -490,6 +490,12 @@ public:
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Get the content of a directory like GetDirectoryContent, but read
+      it from disk at most once per generate step.  Link directory
+      ordering probes the same directories for every target linked, and
+      the libraries it looks for do not change while generating.  */
+  std::set<std::string> const& GetLinkDirectoryContent(std::string const& dir);
+
   void IndexTarget(cmTarget* t);
   void IndexGeneratorTarget(cmGeneratorTarget* gt);
 
@@ -901,10 +907,12 @@ private:
   struct DirectoryContent
   {
     long LastDiskTime = -1;
+    bool LoadedForGenerate = false;
     std::set<std::string> All;
     std::set<std::string> Generated;
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
+  void LoadDirectoryContent(std::string const& dir, DirectoryContent& dc);
 
   // Set of binary directories on disk.
   std::set<std::string> BinaryDirectories;
@@ -1873,8 +1873,8 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
     {
       cmNinjaRule rule("VERIFY_GLOBS");
       rule.Command =
-        cmStrCat(this->CMakeCmd(), " -P ",
-                 lg->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+        cmStrCat(this->CMakeCmd(), " -E cmake_verify_globs ",
+                 lg->ConvertToOutputFormat(cm->GetGlobVerifyData(),
                                            cmOutputConverter::SHELL));
       rule.Description = "Re-checking globbed directories...";
       rule.Comment = "Rule for re-checking globbed directories.";
@@ -1,8 +1,10 @@
 #include "cmInstrumentation.h"
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
+#include <iostream>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -10,6 +12,7 @@
 
 #include <cm/optional>
 
+#include <cm3p/json/reader.h>
 #include <cm3p/json/writer.h>
 #include <cm3p/uv.h>
 
@@ -27,6 +30,102 @@
 #include "cmUVProcessChain.h"
 #include "cmValue.h"
 
+#if defined(_WIN32)
+#  include <windows.h>
+
+#  include "cmsys/Encoding.hxx"
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+
+#  include <sys/stat.h>
+#endif
+
+namespace {
+/** Records appended to the snippet log are written with a single write of
+ * at most this many bytes, which keeps records of concurrent writers from
+ * interleaving.  Larger snippets are written to their own files.
+ **/
+std::size_t const SnippetLogRecordLimit = 64 * 1024;
+
+/** Append a record to the snippet log with a single write.
+ *
+ * On POSIX systems writers hold a shared lock on the log while appending
+ * to it, and append to a new log if indexing renamed the log after they
+ * opened it.  On Windows the log cannot be renamed while it is open.
+ **/
+bool AppendToSnippetLog(std::string const& path, std::string const& record)
+{
+#if defined(_WIN32)
+  HANDLE file = CreateFileW(
+    cmsys::Encoding::ToWindowsExtendedPath(path).c_str(), FILE_APPEND_DATA,
+    FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS,
+    FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  DWORD written = 0;
+  BOOL const ok = WriteFile(file, record.data(),
+                            static_cast<DWORD>(record.size()), &written,
+                            nullptr);
+  CloseHandle(file);
+  return ok && written == record.size();
+#else
+  for (;;) {
+    int const fd = ::open(path.c_str(), O_RDWR | O_APPEND | O_CREAT, 0666);
+    if (fd == -1) {
+      return false;
+    }
+    struct ::flock lock;
+    lock.l_start = 0;
+    lock.l_len = 0;
+    lock.l_pid = 0;
+    lock.l_type = F_RDLCK;
+    lock.l_whence = SEEK_SET;
+    struct stat fileStat;
+    struct stat pathStat;
+    if (::fcntl(fd, F_SETLKW, &lock) == -1 || ::fstat(fd, &fileStat) != 0) {
+      ::close(fd);
+      return false;
+    }
+    if (::stat(path.c_str(), &pathStat) != 0 ||
+        pathStat.st_dev != fileStat.st_dev ||
+        pathStat.st_ino != fileStat.st_ino) {
+      // The log was claimed by indexing after we opened it.
+      ::close(fd);
+      continue;
+    }
+    ssize_t const written = ::write(fd, record.data(), record.size());
+    ::close(fd);
+    return written == static_cast<ssize_t>(record.size());
+  }
+#endif
+}
+
+/** Wait for writers that opened a snippet log before indexing renamed it
+ * to finish appending to it.
+ **/
+void WaitForSnippetLogWriters(std::string const& path)
+{
+#if defined(_WIN32)
+  static_cast<void>(path);
+#else
+  int const fd = ::open(path.c_str(), O_RDWR);
+  if (fd == -1) {
+    return;
+  }
+  struct ::flock lock;
+  lock.l_start = 0;
+  lock.l_len = 0;
+  lock.l_pid = 0;
+  lock.l_type = F_WRLCK;
+  lock.l_whence = SEEK_SET;
+  ::fcntl(fd, F_SETLKW, &lock);
+  ::close(fd);
+#endif
+}
+}
+
 cmInstrumentation::cmInstrumentation(std::string const& binary_dir)
 {
   std::string const uuid =
@@ -226,12 +325,25 @@ int cmInstrumentation::CollectTimingData(cmInstrumentationQuery::Hook hook)
   }
 
   // Touch index file immediately to claim snippets
-  std::string const& directory = cmStrCat(this->timingDirv1, "/data");
-  std::string const& file_name =
+  std::string const directory = cmStrCat(this->timingDirv1, "/data");
+  std::string const file_name =
     cmStrCat("index-", ComputeSuffixTime(), ".json");
   std::string index_path = cmStrCat(directory, '/', file_name);
   cmSystemTools::Touch(index_path, true);
 
+  // Claim the snippet log so that new records start a fresh one
+  std::string log_name;
+  std::string const log_path = cmStrCat(directory, "/snippets.jsonl");
+  if (cmSystemTools::FileExists(log_path, true)) {
+    log_name = cmStrCat("snippets-", ComputeSuffixTime(), ".jsonl");
+    std::string const claimed_path = cmStrCat(directory, '/', log_name);
+    if (cmSystemTools::RenameFile(log_path, claimed_path)) {
+      WaitForSnippetLogWriters(claimed_path);
+    } else {
+      log_name.clear();
+    }
+  }
+
   // Gather Snippets
   using snippet = std::pair<std::string, std::string>;
   std::vector<snippet> files;
@@ -244,7 +356,7 @@ int cmInstrumentation::CollectTimingData(cmInstrumentationQuery::Hook hook)
       if (fname.rfind('.', 0) == 0) {
         continue;
       }
-      if (fname == file_name) {
+      if (fname == file_name || cmHasLiteralSuffix(fname, ".jsonl")) {
         continue;
       }
       if (fname.rfind("index-", 0) == 0) {
@@ -269,6 +381,9 @@ int cmInstrumentation::CollectTimingData(cmInstrumentationQuery::Hook hook)
   index["dataDir"] = directory;
   index["buildDir"] = this->binaryDir;
   index["version"] = 1;
+  if (!log_name.empty()) {
+    index["snippetLog"] = log_name;
+  }
   if (this->HasQuery(cmInstrumentationQuery::Query::StaticSystemInformation)) {
     this->InsertStaticSystemInformation(index);
   }
@@ -301,11 +416,420 @@ int cmInstrumentation::CollectTimingData(cmInstrumentationQuery::Hook hook)
   for (auto const& f : index["snippets"]) {
     cmSystemTools::RemoveFile(cmStrCat(directory, '/', f.asString()));
   }
+  if (!log_name.empty()) {
+    cmSystemTools::RemoveFile(cmStrCat(directory, '/', log_name));
+  }
   cmSystemTools::RemoveFile(index_path);
 
   return 0;
 }
 
+namespace {
+struct SummaryCommand
+{
+  std::string Role;
+  std::string Target;
+  std::string Config;
+  uint64_t Start;
+  uint64_t Duration;
+};
+
+bool IsBuildCommandRole(std::string const& role)
+{
+  return role == "compile" || role == "link" || role == "custom";
+}
+
+bool ReadJSONFile(std::string const& path, Json::Value& root)
+{
+  cmJSONState parseState = cmJSONState(path, &root);
+  return parseState.errors.empty() && root.isObject();
+}
+
+using TargetDependencies = std::map<std::string, std::vector<std::string>>;
+
+/** Read the build-order dependencies between targets of every
+ * configuration from the newest codemodel reply of the file API, if the
+ * build tree has one.
+ **/
+bool ReadCodemodelDependencies(
+  std::string const& build_dir,
+  std::map<std::string, TargetDependencies>& dependencies)
+{
+  std::string const reply_dir = cmStrCat(build_dir, "/.cmake/api/v1/reply");
+  std::string last_index;
+  cmsys::Directory d;
+  if (!d.Load(reply_dir)) {
+    return false;
+  }
+  for (unsigned int i = 0; i < d.GetNumberOfFiles(); i++) {
+    std::string fname = d.GetFile(i);
+    // Reply index names sort by the time they were written.
+    if (fname.rfind("index-", 0) == 0 && cmHasLiteralSuffix(fname, ".json") &&
+        fname > last_index) {
+      last_index = std::move(fname);
+    }
+  }
+  Json::Value index;
+  if (last_index.empty() ||
+      !ReadJSONFile(cmStrCat(reply_dir, '/', last_index), index)) {
+    return false;
+  }
+
+  Json::Value codemodel;
+  for (Json::Value const& object : index["objects"]) {
+    if (object["kind"].asString() == "codemodel" &&
+        object["version"]["major"].asInt() == 2) {
+      ReadJSONFile(cmStrCat(reply_dir, '/', object["jsonFile"].asString()),
+                   codemodel);
+      break;
+    }
+  }
+  Json::Value const& configurations = codemodel["configurations"];
+  if (!configurations.isArray() || configurations.empty()) {
+    return false;
+  }
+
+  for (Json::Value const& configuration : configurations) {
+    TargetDependencies& config_deps =
+      dependencies[configuration["name"].asString()];
+    std::map<std::string, std::string> names;
+    for (Json::Value const& target : configuration["targets"]) {
+      names[target["id"].asString()] = target["name"].asString();
+    }
+    for (Json::Value const& target : configuration["targets"]) {
+      Json::Value target_root;
+      std::vector<std::string>& deps =
+        config_deps[target["name"].asString()];
+      if (!ReadJSONFile(
+            cmStrCat(reply_dir, '/', target["jsonFile"].asString()),
+            target_root)) {
+        continue;
+      }
+      for (Json::Value const& dep : target_root["dependencies"]) {
+        auto name = names.find(dep["id"].asString());
+        if (name != names.end()) {
+          deps.push_back(name->second);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/** Compute the critical path through the target dependency graph.  The
+ * cost of a target is the time it takes with unlimited parallel jobs:
+ * its longest compile followed by its link and custom commands.
+ **/
+void InsertCriticalPath(Json::Value& criticalPath,
+                        TargetDependencies const& dependencies,
+                        std::map<std::string, uint64_t> const& costs)
+{
+  enum class Mark
+  {
+    None,
+    Visiting,
+    Done
+  };
+  struct Node
+  {
+    uint64_t Cost = 0;
+    uint64_t Finish = 0;
+    uint64_t Tail = 0;
+    std::string Prev;
+    std::vector<std::string> Deps;
+    Mark State = Mark::None;
+  };
+  std::map<std::string, Node> nodes;
+  for (auto const& cost : costs) {
+    nodes[cost.first].Cost = cost.second;
+  }
+  for (auto const& target : dependencies) {
+    nodes[target.first];
+  }
+
+  // Longest path ending at each target, in dependency order.  Edges
+  // closing a cycle are ignored, here and below.
+  std::vector<std::string> order;
+  std::function<void(std::string const&)> visit =
+    [&](std::string const& name) {
+      Node& node = nodes[name];
+      if (node.State != Mark::None) {
+        return;
+      }
+      node.State = Mark::Visiting;
+      uint64_t start = 0;
+      auto deps = dependencies.find(name);
+      if (deps != dependencies.end()) {
+        for (std::string const& dep : deps->second) {
+          visit(dep);
+          Node const& depNode = nodes[dep];
+          if (depNode.State != Mark::Done) {
+            continue;
+          }
+          node.Deps.push_back(dep);
+          if (depNode.Finish > start) {
+            start = depNode.Finish;
+            node.Prev = dep;
+          }
+        }
+      }
+      node.Finish = start + node.Cost;
+      node.State = Mark::Done;
+      order.push_back(name);
+    };
+  for (auto const& node : nodes) {
+    visit(node.first);
+  }
+
+  // Longest path following each target, in reverse dependency order.
+  for (auto i = order.rbegin(); i != order.rend(); ++i) {
+    Node const& node = nodes[*i];
+    for (std::string const& dep : node.Deps) {
+      Node& depNode = nodes[dep];
+      depNode.Tail = std::max(depNode.Tail, node.Cost + node.Tail);
+    }
+  }
+
+  std::string last;
+  uint64_t length = 0;
+  for (auto const& node : nodes) {
+    if (last.empty() || node.second.Finish > length) {
+      last = node.first;
+      length = node.second.Finish;
+    }
+  }
+
+  Json::Value& targets = criticalPath["targets"] = Json::objectValue;
+  for (auto const& node : nodes) {
+    if (costs.find(node.first) == costs.end()) {
+      continue;
+    }
+    uint64_t const through = node.second.Finish + node.second.Tail;
+    Json::Value& target = targets[node.first];
+    target["cost"] = static_cast<Json::Value::UInt64>(node.second.Cost);
+    target["slack"] = static_cast<Json::Value::UInt64>(
+      through < length ? length - through : 0);
+  }
+
+  criticalPath["duration"] = static_cast<Json::Value::UInt64>(length);
+  std::vector<std::string> path;
+  for (std::string name = last; !name.empty(); name = nodes[name].Prev) {
+    path.push_back(name);
+  }
+  criticalPath["path"] = Json::arrayValue;
+  for (auto i = path.rbegin(); i != path.rend(); ++i) {
+    criticalPath["path"].append(*i);
+  }
+
+  // The targets whose own cost lengthens the critical path the most are
+  // the best candidates for splitting.
+  std::sort(path.begin(), path.end(),
+            [&nodes](std::string const& l, std::string const& r) {
+              return nodes[l].Cost > nodes[r].Cost;
+            });
+  criticalPath["bottlenecks"] = Json::arrayValue;
+  for (std::string const& name : path) {
+    if (nodes[name].Cost == 0) {
+      break;
+    }
+    Json::Value bottleneck(Json::objectValue);
+    bottleneck["target"] = name;
+    bottleneck["cost"] = static_cast<Json::Value::UInt64>(nodes[name].Cost);
+    criticalPath["bottlenecks"].append(bottleneck);
+  }
+}
+}
+
+/*
+ * Called by ctest --summarize-instrumentation. Aggregates the snippets
+ * listed by an index file, or those pending in a build tree, into per-role
+ * and per-target totals along with the build parallelism over time.
+ */
+int cmInstrumentation::SummarizeTimingData(std::string const& path)
+{
+  std::string data_dir;
+  std::string build_dir;
+  std::vector<std::string> snippets;
+  std::vector<std::string> logs;
+  if (cmSystemTools::FileIsDirectory(path)) {
+    build_dir = path;
+    std::string const uuid =
+      cmExperimental::DataForFeature(cmExperimental::Feature::Instrumentation)
+        .Uuid;
+    data_dir = cmStrCat(path, "/.cmake/instrumentation-", uuid, "/v1/data");
+    cmsys::Directory d;
+    if (d.Load(data_dir)) {
+      for (unsigned int i = 0; i < d.GetNumberOfFiles(); i++) {
+        std::string fname = d.GetFile(i);
+        if (fname.rfind('.', 0) == 0 || fname.rfind("index-", 0) == 0) {
+          continue;
+        }
+        if (cmHasLiteralSuffix(fname, ".jsonl")) {
+          logs.push_back(std::move(fname));
+        } else if (cmHasLiteralSuffix(fname, ".json")) {
+          snippets.push_back(std::move(fname));
+        }
+      }
+    }
+  } else {
+    Json::Value index;
+    cmJSONState parseState = cmJSONState(path, &index);
+    if (!parseState.errors.empty()) {
+      cmSystemTools::Error(parseState.GetErrorMessage(true));
+      return 1;
+    }
+    if (!index.isObject() || !index["snippets"].isArray()) {
+      cmSystemTools::Error(cmStrCat("Expected index file ", path,
+                                    " to have a key 'snippets'"));
+      return 1;
+    }
+    data_dir = index["dataDir"].asString();
+    build_dir = index["buildDir"].asString();
+    for (auto const& snippet : index["snippets"]) {
+      snippets.push_back(snippet.asString());
+    }
+    if (index.isMember("snippetLog")) {
+      logs.push_back(index["snippetLog"].asString());
+    }
+  }
+
+  std::vector<SummaryCommand> commands;
+  auto addSnippet = [&commands](std::string const&,
+                                Json::Value const& snippet) {
+    if (!snippet.isObject()) {
+      return;
+    }
+    commands.push_back({ snippet["role"].asString(),
+                         snippet["target"].asString(),
+                         snippet["config"].asString(),
+                         snippet["timeStart"].asUInt64(),
+                         snippet["duration"].asUInt64() });
+  };
+  for (std::string const& snippet : snippets) {
+    std::string const snippet_path = cmStrCat(data_dir, '/', snippet);
+    Json::Value snippet_root;
+    cmJSONState parseState = cmJSONState(snippet_path, &snippet_root);
+    if (!parseState.errors.empty()) {
+      cmSystemTools::Error(parseState.GetErrorMessage(true));
+      continue;
+    }
+    addSnippet(snippet, snippet_root);
+  }
+  for (std::string const& log : logs) {
+    ReadSnippetLog(cmStrCat(data_dir, '/', log), addSnippet);
+  }
+
+  Json::Value summary(Json::objectValue);
+  summary["version"] = 1;
+  summary["roles"] = Json::objectValue;
+  summary["targets"] = Json::objectValue;
+
+  // Build commands contribute to the parallelism profile as +1/-1 events.
+  // At equal times, completions sort before starts.
+  std::vector<std::pair<uint64_t, int>> events;
+  uint64_t commandTime = 0;
+  // Costs of the targets of each configuration.
+  std::map<std::string, std::map<std::string, uint64_t>> longestCompile;
+  std::map<std::string, std::map<std::string, uint64_t>> costs;
+  for (SummaryCommand const& command : commands) {
+    Json::Value& role = summary["roles"][command.Role];
+    role["count"] = role["count"].asUInt64() + 1;
+    role["duration"] = static_cast<Json::Value::UInt64>(
+      role["duration"].asUInt64() + command.Duration);
+    if (!IsBuildCommandRole(command.Role)) {
+      continue;
+    }
+    if (!command.Target.empty()) {
+      Json::Value& target = summary["targets"][command.Target];
+      target["count"] = target["count"].asUInt64() + 1;
+      target["duration"] = static_cast<Json::Value::UInt64>(
+        target["duration"].asUInt64() + command.Duration);
+      target[command.Role] = static_cast<Json::Value::UInt64>(
+        target[command.Role].asUInt64() + command.Duration);
+      if (command.Role == "compile") {
+        uint64_t& longest = longestCompile[command.Config][command.Target];
+        longest = std::max(longest, command.Duration);
+      } else {
+        costs[command.Config][command.Target] += command.Duration;
+      }
+    }
+    commandTime += command.Duration;
+    events.emplace_back(command.Start, 1);
+    events.emplace_back(command.Start + command.Duration, -1);
+  }
+  std::sort(events.begin(), events.end());
+
+  uint64_t wallTime = 0;
+  int maxJobs = 0;
+  Json::Value& parallelism = summary["parallelism"] = Json::arrayValue;
+  if (!events.empty()) {
+    uint64_t const begin = events.front().first;
+    wallTime = events.back().first - begin;
+    int jobs = 0;
+    for (auto i = events.begin(); i != events.end();) {
+      uint64_t const time = i->first;
+      for (; i != events.end() && i->first == time; ++i) {
+        jobs += i->second;
+      }
+      maxJobs = std::max(maxJobs, jobs);
+      Json::Value point(Json::objectValue);
+      point["time"] = static_cast<Json::Value::UInt64>(time - begin);
+      point["jobs"] = jobs;
+      parallelism.append(point);
+    }
+  }
+  summary["wallTime"] = static_cast<Json::Value::UInt64>(wallTime);
+  summary["commandTime"] = static_cast<Json::Value::UInt64>(commandTime);
+  summary["maxParallelism"] = maxJobs;
+  summary["averageParallelism"] = wallTime == 0
+    ? static_cast<double>(maxJobs)
+    : static_cast<double>(commandTime) / static_cast<double>(wallTime);
+
+  std::map<std::string, TargetDependencies> dependencies;
+  if (ReadCodemodelDependencies(build_dir, dependencies)) {
+    for (auto const& config : longestCompile) {
+      for (auto const& longest : config.second) {
+        costs[config.first][longest.first] += longest.second;
+      }
+    }
+    // Commands that do not record a configuration, such as those of custom
+    // targets, are part of every configuration built.
+    auto unknown = costs.find(std::string());
+    if (unknown != costs.end() && costs.size() > 1) {
+      for (auto& config : costs) {
+        if (config.first.empty()) {
+          continue;
+        }
+        for (auto const& cost : unknown->second) {
+          config.second[cost.first] += cost.second;
+        }
+      }
+      costs.erase(unknown);
+    }
+    Json::Value& criticalPaths = summary["criticalPath"] = Json::arrayValue;
+    for (auto const& config : costs) {
+      auto deps = dependencies.find(config.first);
+      if (deps == dependencies.end()) {
+        // A single-config codemodel may name the configuration differently
+        // than the snippets do when no build type is set.
+        if (dependencies.size() != 1) {
+          continue;
+        }
+        deps = dependencies.begin();
+      }
+      Json::Value criticalPath(Json::objectValue);
+      criticalPath["config"] = config.first;
+      InsertCriticalPath(criticalPath, deps->second, config.second);
+      criticalPaths.append(std::move(criticalPath));
+    }
+  }
+
+  Json::StreamWriterBuilder wbuilder;
+  wbuilder["indentation"] = "  ";
+  std::cout << Json::writeString(wbuilder, summary) << std::endl;
+  return 0;
+}
+
 void cmInstrumentation::InsertDynamicSystemInformation(
   Json::Value& root, std::string const& prefix)
 {
@@ -386,7 +910,7 @@ void cmInstrumentation::WriteInstrumentationJson(Json::Value& root,
   wbuilder["indentation"] = "\t";
   std::unique_ptr<Json::StreamWriter> JsonWriter =
     std::unique_ptr<Json::StreamWriter>(wbuilder.newStreamWriter());
-  std::string const& directory = cmStrCat(this->timingDirv1, '/', subdir);
+  std::string const directory = cmStrCat(this->timingDirv1, '/', subdir);
   cmSystemTools::MakeDirectory(directory);
   cmsys::ofstream ftmp(cmStrCat(directory, '/', file_name).c_str());
   JsonWriter->write(root, &ftmp);
@@ -394,6 +918,67 @@ void cmInstrumentation::WriteInstrumentationJson(Json::Value& root,
   ftmp.close();
 }
 
+void cmInstrumentation::WriteInstrumentationSnippet(
+  Json::Value& root, std::string const& file_name)
+{
+  if (!this->HasQuery(cmInstrumentationQuery::Query::SnippetLog)) {
+    this->WriteInstrumentationJson(root, "data", file_name);
+    return;
+  }
+
+  // Append the snippet to the log as one line written at once so that
+  // records from concurrent commands do not interleave.  Records too large
+  // for that are written to a snippet file instead.
+  root["snippet"] = file_name;
+  Json::StreamWriterBuilder wbuilder;
+  wbuilder["indentation"] = "";
+  std::string const line = cmStrCat(Json::writeString(wbuilder, root), '\n');
+  std::string const directory = cmStrCat(this->timingDirv1, "/data");
+  cmSystemTools::MakeDirectory(directory);
+  if (line.size() > SnippetLogRecordLimit ||
+      !AppendToSnippetLog(cmStrCat(directory, "/snippets.jsonl"), line)) {
+    root.removeMember("snippet");
+    this->WriteInstrumentationJson(root, "data", file_name);
+  }
+}
+
+bool cmInstrumentation::ReadSnippetLog(std::string const& path,
+                                       SnippetCallback const& callback)
+{
+  cmsys::ifstream flog(path.c_str(), std::ios::in | std::ios::binary);
+  if (!flog) {
+    cmSystemTools::Error(cmStrCat("Failed to read snippet log ", path));
+    return false;
+  }
+  Json::CharReaderBuilder rbuilder;
+  std::unique_ptr<Json::CharReader> const reader(rbuilder.newCharReader());
+  std::string line;
+  unsigned long lineNumber = 0;
+  while (std::getline(flog, line)) {
+    ++lineNumber;
+    if (flog.eof()) {
+      // The last record of a log still being written may be incomplete.
+      break;
+    }
+    if (line.empty()) {
+      continue;
+    }
+    Json::Value snippet;
+    std::string errors;
+    if (!reader->parse(line.data(), line.data() + line.size(), &snippet,
+                       &errors) ||
+        !snippet.isObject() || !snippet["snippet"].isString()) {
+      cmSystemTools::Message(cmStrCat("Ignoring malformed record on line ",
+                                      lineNumber, " of snippet log\n  ",
+                                      path, '\n', errors),
+                             "Warning");
+      continue;
+    }
+    callback(snippet["snippet"].asString(), snippet);
+  }
+  return true;
+}
+
 std::string cmInstrumentation::InstrumentTest(
   std::string const& name, std::string const& command,
   std::vector<std::string> const& args, int64_t result,
@@ -423,7 +1008,7 @@ std::string cmInstrumentation::InstrumentTest(
     "test-",
     this->ComputeSuffixHash(cmStrCat(command_str, info.GetProcessId())),
     this->ComputeSuffixTime(), ".json");
-  this->WriteInstrumentationJson(root, "data", file_name);
+  this->WriteInstrumentationSnippet(root, file_name);
   return file_name;
 }
 
@@ -545,7 +1130,7 @@ int cmInstrumentation::InstrumentCommand(
     command_type, '-',
     this->ComputeSuffixHash(cmStrCat(command_str, info.GetProcessId())),
     this->ComputeSuffixTime(), ".json");
-  this->WriteInstrumentationJson(root, "data", file_name);
+  this->WriteInstrumentationSnippet(root, file_name);
   return ret;
 }
 
@@ -683,7 +1268,6 @@ void cmInstrumentation::PrepareDataForCDash(std::string const& data_dir,
     return;
   }
 
-  std::string dst_dir;
   Json::Value snippets = root["snippets"];
   for (auto const& snippet : snippets) {
     // Parse the role of this snippet.
@@ -695,46 +1279,11 @@ void cmInstrumentation::PrepareDataForCDash(std::string const& data_dir,
       cmSystemTools::Error(parseState.GetErrorMessage(true));
       continue;
     }
-    if (!snippet_root.isObject()) {
-      error_msg = cmStrCat("Expected snippet file ", snippet_path,
-                           " to contain an object");
-      cmSystemTools::Error(error_msg);
-      continue;
-    }
-    if (!snippet_root.isMember("role")) {
-      error_msg = cmStrCat("Expected snippet file ", snippet_path,
-                           " to have a key 'role'");
-      cmSystemTools::Error(error_msg);
-      continue;
-    }
-
-    std::string snippet_role = snippet_root["role"].asString();
-    auto map_element = this->cdashSnippetsMap.find(snippet_role);
-    if (map_element == this->cdashSnippetsMap.end()) {
-      std::string message =
-        "Unexpected snippet type encountered: " + snippet_role;
-      cmSystemTools::Message(message, "Warning");
-      continue;
-    }
-
-    if (map_element->second == "skip") {
+    std::string dst_dir = this->GetCDashSnippetDir(snippet_path, snippet_root);
+    if (dst_dir.empty()) {
       continue;
     }
 
-    if (map_element->second == "build") {
-      // We organize snippets on a per-target basis (when possible)
-      // for Build.xml.
-      if (snippet_root.isMember("target")) {
-        dst_dir = cmStrCat(this->cdashDir, "/build/targets/",
-                           snippet_root["target"].asString());
-        cmSystemTools::MakeDirectory(dst_dir);
-      } else {
-        dst_dir = cmStrCat(this->cdashDir, "/build/commands");
-      }
-    } else {
-      dst_dir = cmStrCat(this->cdashDir, '/', map_element->second);
-    }
-
     std::string dst = cmStrCat(dst_dir, '/', snippet_str);
     cmsys::Status copied = cmSystemTools::CopyFileAlways(snippet_path, dst);
     if (!copied) {
@@ -742,4 +1291,77 @@ void cmInstrumentation::PrepareDataForCDash(std::string const& data_dir,
       cmSystemTools::Error(error_msg);
     }
   }
+
+  // Records from a snippet log are written out as individual snippet files.
+  if (root.isMember("snippetLog")) {
+    std::string const log_path =
+      cmStrCat(data_dir, '/', root["snippetLog"].asString());
+    Json::StreamWriterBuilder wbuilder;
+    wbuilder["indentation"] = "\t";
+    auto writeSnippet = [this, &log_path, &wbuilder](
+                          std::string const& snippet_str,
+                          Json::Value const& snippet_root) {
+      std::string dst_dir = this->GetCDashSnippetDir(log_path, snippet_root);
+      if (dst_dir.empty() || snippet_str.empty()) {
+        return;
+      }
+      std::string dst = cmStrCat(dst_dir, '/', snippet_str);
+      cmsys::ofstream fout(dst.c_str());
+      fout << Json::writeString(wbuilder, snippet_root) << '\n';
+      if (!fout) {
+        cmSystemTools::Error(cmStrCat("Failed to write ", dst));
+      }
+    };
+    ReadSnippetLog(log_path, writeSnippet);
+  }
+}
+
+/** Return the directory a snippet is organized into for submission to
+ * CDash, or an empty string if it is not submitted.
+ **/
+std::string cmInstrumentation::GetCDashSnippetDir(
+  std::string const& snippet_path, Json::Value const& snippet_root)
+{
+  std::string error_msg;
+  if (!snippet_root.isObject()) {
+    error_msg = cmStrCat("Expected snippet file ", snippet_path,
+                         " to contain an object");
+    cmSystemTools::Error(error_msg);
+    return std::string();
+  }
+  if (!snippet_root.isMember("role")) {
+    error_msg = cmStrCat("Expected snippet file ", snippet_path,
+                         " to have a key 'role'");
+    cmSystemTools::Error(error_msg);
+    return std::string();
+  }
+
+  std::string snippet_role = snippet_root["role"].asString();
+  auto map_element = this->cdashSnippetsMap.find(snippet_role);
+  if (map_element == this->cdashSnippetsMap.end()) {
+    std::string message =
+      "Unexpected snippet type encountered: " + snippet_role;
+    cmSystemTools::Message(message, "Warning");
+    return std::string();
+  }
+
+  if (map_element->second == "skip") {
+    return std::string();
+  }
+
+  std::string dst_dir;
+  if (map_element->second == "build") {
+    // We organize snippets on a per-target basis (when possible)
+    // for Build.xml.
+    if (snippet_root.isMember("target")) {
+      dst_dir = cmStrCat(this->cdashDir, "/build/targets/",
+                         snippet_root["target"].asString());
+      cmSystemTools::MakeDirectory(dst_dir);
+    } else {
+      dst_dir = cmStrCat(this->cdashDir, "/build/commands");
+    }
+  } else {
+    dst_dir = cmStrCat(this->cdashDir, '/', map_element->second);
+  }
+  return dst_dir;
 }
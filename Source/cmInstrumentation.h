@@ -49,6 +49,7 @@ public:
                       std::vector<std::vector<std::string>> const& callback);
   void ClearGeneratedQueries();
   int CollectTimingData(cmInstrumentationQuery::Hook hook);
+  static int SummarizeTimingData(std::string const& path);
   int SpawnBuildDaemon();
   int CollectTimingAfterBuild(int ppid);
   void AddHook(cmInstrumentationQuery::Hook hook);
@@ -60,6 +61,12 @@ private:
   void WriteInstrumentationJson(Json::Value& index,
                                 std::string const& directory,
                                 std::string const& file_name);
+  void WriteInstrumentationSnippet(Json::Value& root,
+                                   std::string const& file_name);
+  using SnippetCallback =
+    std::function<void(std::string const& name, Json::Value const& snippet)>;
+  static bool ReadSnippetLog(std::string const& path,
+                             SnippetCallback const& callback);
   static void InsertStaticSystemInformation(Json::Value& index);
   static void GetDynamicSystemInformation(double& memory, double& load);
   static void InsertDynamicSystemInformation(Json::Value& index,
@@ -73,6 +80,8 @@ private:
   static std::string ComputeSuffixTime();
   void PrepareDataForCDash(std::string const& data_dir,
                            std::string const& index_path);
+  std::string GetCDashSnippetDir(std::string const& snippet_path,
+                                 Json::Value const& snippet_root);
   std::string binaryDir;
   std::string timingDirv1;
   std::string userTimingDirv1;
@@ -15,7 +15,8 @@ public:
   enum Query
   {
     StaticSystemInformation,
-    DynamicSystemInformation
+    DynamicSystemInformation,
+    SnippetLog
   };
   static std::vector<std::string> const QueryString;
 
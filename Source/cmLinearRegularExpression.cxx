@@ -0,0 +1,596 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmLinearRegularExpression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <cm/string_view>
+
+namespace {
+// Subexpressions are limited as in cmsys::RegularExpression.
+int const MaxGroups = 31;
+
+std::size_t const NoPos = static_cast<std::size_t>(-1);
+
+// A restore entry on the thread stack has this bit set.
+std::size_t const RestoreBit = ~(NoPos >> 1);
+
+bool IsMult(char c)
+{
+  return c == '*' || c == '+' || c == '?';
+}
+}
+
+/* Parses a pattern with the grammar of cmsys::RegularExpression into a
+   tree, then emits the program.  Patterns rejected there are rejected
+   here too, including loops over an expression that may be empty.  */
+class cmLinearRegularExpression::Compiler
+{
+public:
+  Compiler(cmLinearRegularExpression& regex, char const* pattern)
+    : Regex(regex)
+    , Parse(pattern)
+  {
+  }
+
+  bool Run();
+
+private:
+  enum class Kind
+  {
+    Char,
+    Any,
+    Class,
+    Bol,
+    Eol,
+    Group,
+    Concat,
+    Alternate,
+    Star,
+    Plus,
+    Quest,
+  };
+
+  struct Node
+  {
+    Kind K;
+    std::size_t Arg;
+    std::vector<std::size_t> Children;
+  };
+
+  std::size_t Add(Kind k, std::size_t arg = 0)
+  {
+    this->Nodes.push_back(Node{ k, arg, {} });
+    return this->Nodes.size() - 1;
+  }
+
+  bool ParseAlternate(bool paren, std::size_t& node, bool& width);
+  bool ParseConcat(std::size_t& node, bool& width);
+  bool ParsePiece(std::size_t& node, bool& width);
+  bool ParseAtom(std::size_t& node, bool& width);
+  bool ParseClass(std::size_t& node);
+
+  void EmitNode(std::size_t node);
+  std::size_t Emit(Opcode op, std::size_t arg = 0, std::size_t next = 0)
+  {
+    this->Regex.Program.push_back(Instruction{ op, arg, next });
+    return this->Regex.Program.size() - 1;
+  }
+
+  void FindHints(std::size_t root);
+
+  cmLinearRegularExpression& Regex;
+  char const* Parse;
+  std::vector<Node> Nodes;
+};
+
+bool cmLinearRegularExpression::Compiler::Run()
+{
+  std::size_t root;
+  bool width;
+  if (!this->ParseAlternate(false, root, width)) {
+    return false;
+  }
+
+  // The whole match is subexpression 0.
+  this->Emit(Opcode::Save, 0);
+  this->EmitNode(root);
+  this->Emit(Opcode::Save, 1);
+  this->Emit(Opcode::Match);
+  this->FindHints(root);
+  return true;
+}
+
+bool cmLinearRegularExpression::Compiler::ParseAlternate(bool paren,
+                                                         std::size_t& node,
+                                                         bool& width)
+{
+  std::size_t group = 0;
+  if (paren) {
+    if (this->Regex.Groups >= MaxGroups) {
+      return false;
+    }
+    group = static_cast<std::size_t>(++this->Regex.Groups);
+  }
+
+  std::size_t branch;
+  if (!this->ParseConcat(branch, width)) {
+    return false;
+  }
+  node = branch;
+  if (*this->Parse == '|') {
+    node = this->Add(Kind::Alternate);
+    this->Nodes[node].Children.push_back(branch);
+    while (*this->Parse == '|') {
+      ++this->Parse;
+      bool branchWidth;
+      if (!this->ParseConcat(branch, branchWidth)) {
+        return false;
+      }
+      this->Nodes[node].Children.push_back(branch);
+      width = width && branchWidth;
+    }
+  }
+
+  if (paren) {
+    if (*this->Parse++ != ')') {
+      return false;
+    }
+    std::size_t const inner = node;
+    node = this->Add(Kind::Group, group);
+    this->Nodes[node].Children.push_back(inner);
+  } else if (*this->Parse != '\0') {
+    return false;
+  }
+  return true;
+}
+
+bool cmLinearRegularExpression::Compiler::ParseConcat(std::size_t& node,
+                                                      bool& width)
+{
+  node = this->Add(Kind::Concat);
+  width = false;
+  while (*this->Parse != '\0' && *this->Parse != '|' &&
+         *this->Parse != ')') {
+    std::size_t piece;
+    bool pieceWidth;
+    if (!this->ParsePiece(piece, pieceWidth)) {
+      return false;
+    }
+    this->Nodes[node].Children.push_back(piece);
+    width = width || pieceWidth;
+  }
+  return true;
+}
+
+bool cmLinearRegularExpression::Compiler::ParsePiece(std::size_t& node,
+                                                     bool& width)
+{
+  std::size_t atom;
+  if (!this->ParseAtom(atom, width)) {
+    return false;
+  }
+  char const op = *this->Parse;
+  if (!IsMult(op)) {
+    node = atom;
+    return true;
+  }
+  if (!width && op != '?') {
+    return false;
+  }
+  ++this->Parse;
+  if (IsMult(*this->Parse)) {
+    return false;
+  }
+
+  Kind const k =
+    op == '*' ? Kind::Star : (op == '+' ? Kind::Plus : Kind::Quest);
+  node = this->Add(k);
+  this->Nodes[node].Children.push_back(atom);
+  width = op == '+';
+  return true;
+}
+
+bool cmLinearRegularExpression::Compiler::ParseAtom(std::size_t& node,
+                                                    bool& width)
+{
+  width = true;
+  char const c = *this->Parse++;
+  switch (c) {
+    case '^':
+      node = this->Add(Kind::Bol);
+      width = false;
+      return true;
+    case '$':
+      node = this->Add(Kind::Eol);
+      width = false;
+      return true;
+    case '.':
+      node = this->Add(Kind::Any);
+      return true;
+    case '[':
+      return this->ParseClass(node);
+    case '(':
+      return this->ParseAlternate(true, node, width);
+    case '\0':
+    case '|':
+    case ')':
+    case '?':
+    case '+':
+    case '*':
+      return false;
+    case '\\':
+      if (*this->Parse == '\0') {
+        return false;
+      }
+      node = this->Add(Kind::Char, static_cast<unsigned char>(*this->Parse));
+      ++this->Parse;
+      return true;
+    default:
+      node = this->Add(Kind::Char, static_cast<unsigned char>(c));
+      return true;
+  }
+}
+
+bool cmLinearRegularExpression::Compiler::ParseClass(std::size_t& node)
+{
+  std::bitset<256> members;
+  bool const complement = *this->Parse == '^';
+  if (complement) {
+    ++this->Parse;
+  }
+  if (*this->Parse == ']' || *this->Parse == '-') {
+    members.set(static_cast<unsigned char>(*this->Parse++));
+  }
+  while (*this->Parse != '\0' && *this->Parse != ']') {
+    if (*this->Parse != '-') {
+      members.set(static_cast<unsigned char>(*this->Parse++));
+      continue;
+    }
+    ++this->Parse;
+    if (*this->Parse == ']' || *this->Parse == '\0') {
+      members.set('-');
+      continue;
+    }
+    // A range continues from the character written before the '-'.
+    unsigned int const first =
+      static_cast<unsigned char>(*(this->Parse - 2)) + 1u;
+    unsigned int const last = static_cast<unsigned char>(*this->Parse);
+    if (first > last + 1) {
+      return false;
+    }
+    for (unsigned int r = first; r <= last; ++r) {
+      members.set(r);
+    }
+    ++this->Parse;
+  }
+  if (*this->Parse != ']') {
+    return false;
+  }
+  ++this->Parse;
+
+  if (complement) {
+    members.flip();
+  }
+  // The end of the string never matches a class.
+  members.reset(0);
+  this->Regex.Classes.push_back(members);
+  node = this->Add(Kind::Class, this->Regex.Classes.size() - 1);
+  return true;
+}
+
+void cmLinearRegularExpression::Compiler::EmitNode(std::size_t node)
+{
+  Node const& n = this->Nodes[node];
+  std::size_t const arg = n.Arg;
+  std::vector<std::size_t> const& children = n.Children;
+  std::vector<Instruction>& program = this->Regex.Program;
+
+  switch (n.K) {
+    case Kind::Char:
+      this->Emit(Opcode::Char, arg);
+      break;
+    case Kind::Any:
+      this->Emit(Opcode::Any);
+      break;
+    case Kind::Class:
+      this->Emit(Opcode::Class, arg);
+      break;
+    case Kind::Bol:
+      this->Emit(Opcode::Bol);
+      break;
+    case Kind::Eol:
+      this->Emit(Opcode::Eol);
+      break;
+    case Kind::Group:
+      this->Emit(Opcode::Save, 2 * arg);
+      this->EmitNode(children.front());
+      this->Emit(Opcode::Save, 2 * arg + 1);
+      break;
+    case Kind::Concat:
+      for (std::size_t child : children) {
+        this->EmitNode(child);
+      }
+      break;
+    case Kind::Alternate: {
+      // Earlier alternatives take priority.
+      std::vector<std::size_t> jumps;
+      for (std::size_t i = 0; i + 1 < children.size(); ++i) {
+        std::size_t const split = this->Emit(Opcode::Split);
+        program[split].Arg = split + 1;
+        this->EmitNode(children[i]);
+        jumps.push_back(this->Emit(Opcode::Jump));
+        program[split].Next = program.size();
+      }
+      this->EmitNode(children.back());
+      for (std::size_t jump : jumps) {
+        program[jump].Arg = program.size();
+      }
+    } break;
+    case Kind::Star: {
+      std::size_t const split = this->Emit(Opcode::Split);
+      program[split].Arg = split + 1;
+      this->EmitNode(children.front());
+      this->Emit(Opcode::Jump, split);
+      program[split].Next = program.size();
+    } break;
+    case Kind::Plus: {
+      std::size_t const body = program.size();
+      this->EmitNode(children.front());
+      std::size_t const split = this->Emit(Opcode::Split, body);
+      program[split].Next = split + 1;
+    } break;
+    case Kind::Quest: {
+      std::size_t const split = this->Emit(Opcode::Split);
+      program[split].Arg = split + 1;
+      this->EmitNode(children.front());
+      program[split].Next = program.size();
+    } break;
+  }
+}
+
+void cmLinearRegularExpression::Compiler::FindHints(std::size_t root)
+{
+  // Like cmsys::RegularExpression, only look at a pattern made of a
+  // single top-level branch.
+  Node const& top = this->Nodes[root];
+  if (top.K != Kind::Concat || top.Children.empty()) {
+    return;
+  }
+  Node const& first = this->Nodes[top.Children.front()];
+  if (first.K == Kind::Bol) {
+    this->Regex.Anchored = true;
+  } else if (first.K == Kind::Char) {
+    this->Regex.FirstChar = static_cast<int>(first.Arg);
+  }
+
+  // The longest run of plain characters must appear in every match.
+  std::string run;
+  for (std::size_t child : top.Children) {
+    Node const& piece = this->Nodes[child];
+    if (piece.K == Kind::Char) {
+      run += static_cast<char>(piece.Arg);
+    } else {
+      run.clear();
+    }
+    if (run.size() > this->Regex.Required.size()) {
+      this->Regex.Required = run;
+    }
+  }
+  if (this->Regex.Required.size() < 2) {
+    this->Regex.Required.clear();
+  }
+}
+
+cmLinearRegularExpression::cmLinearRegularExpression(
+  std::string const& pattern)
+{
+  this->compile(pattern);
+}
+
+bool cmLinearRegularExpression::compile(std::string const& pattern)
+{
+  this->Program.clear();
+  this->Classes.clear();
+  this->Groups = 0;
+  this->Anchored = false;
+  this->FirstChar = -1;
+  this->Required.clear();
+  this->SearchString = nullptr;
+  this->Result.clear();
+
+  // The pattern ends at its first null character, as in cmsys.
+  Compiler compiler(*this, pattern.c_str());
+  if (!compiler.Run()) {
+    this->Program.clear();
+    this->Classes.clear();
+    this->Groups = 0;
+    return false;
+  }
+  std::size_t const slots = 2 * static_cast<std::size_t>(this->Groups + 1);
+  this->Marks.assign(this->Program.size(), 0);
+  this->Generation = 0;
+  this->StartSlots.assign(slots, NoPos);
+  return true;
+}
+
+void cmLinearRegularExpression::AddThread(ThreadList& list, std::size_t pc,
+                                          std::size_t* slots,
+                                          std::size_t pos)
+{
+  // Follow the empty transitions depth first in priority order.  The
+  // first thread to reach an instruction at this position wins it.
+  this->Stack.clear();
+  this->Stack.push_back(pc);
+  while (!this->Stack.empty()) {
+    std::size_t const entry = this->Stack.back();
+    this->Stack.pop_back();
+    if (entry & RestoreBit) {
+      std::size_t const value = this->Stack.back();
+      this->Stack.pop_back();
+      slots[entry & ~RestoreBit] = value;
+      continue;
+    }
+    if (this->Marks[entry] == this->Generation) {
+      continue;
+    }
+    this->Marks[entry] = this->Generation;
+
+    Instruction const& in = this->Program[entry];
+    switch (in.Op) {
+      case Opcode::Jump:
+        this->Stack.push_back(in.Arg);
+        break;
+      case Opcode::Split:
+        this->Stack.push_back(in.Next);
+        this->Stack.push_back(in.Arg);
+        break;
+      case Opcode::Save:
+        this->Stack.push_back(slots[in.Arg]);
+        this->Stack.push_back(in.Arg | RestoreBit);
+        slots[in.Arg] = pos;
+        this->Stack.push_back(entry + 1);
+        break;
+      case Opcode::Bol:
+        if (pos == this->Bol) {
+          this->Stack.push_back(entry + 1);
+        }
+        break;
+      case Opcode::Eol:
+        if (pos == this->Length) {
+          this->Stack.push_back(entry + 1);
+        }
+        break;
+      default:
+        list.Pcs.push_back(entry);
+        list.Slots.insert(list.Slots.end(), slots,
+                          slots + this->StartSlots.size());
+        break;
+    }
+  }
+}
+
+bool cmLinearRegularExpression::find(char const* string,
+                                     std::string::size_type offset,
+                                     unsigned options)
+{
+  this->SearchString = string;
+  this->Result.clear();
+  if (this->Program.empty()) {
+    return false;
+  }
+
+  this->Input = string;
+  this->Length = std::strlen(string);
+  this->Bol = (options & BOL_AT_OFFSET) ? offset : 0;
+  this->Reject = (options & NONEMPTY_AT_OFFSET) ? offset : NoPos;
+
+  // Give up early if a literal that every match contains is missing.
+  if (!this->Required.empty() &&
+      cm::string_view(string + offset, this->Length - offset)
+          .find(this->Required) == cm::string_view::npos) {
+    return false;
+  }
+
+  std::size_t const slots = this->StartSlots.size();
+  ThreadList& current = this->Current;
+  ThreadList& pending = this->Pending;
+  current.Pcs.clear();
+  current.Slots.clear();
+  ++this->Generation;
+
+  bool matched = false;
+  for (std::size_t pos = offset;; ++pos) {
+    // Start a new attempt at this position unless an attempt at an
+    // earlier position already matched.  It has the lowest priority.
+    if (!matched && pos <= this->Length &&
+        (!this->Anchored || pos == offset)) {
+      if (current.Pcs.empty() && this->FirstChar >= 0) {
+        void const* next = std::memchr(string + pos, this->FirstChar,
+                                       this->Length - pos);
+        if (!next) {
+          break;
+        }
+        pos = static_cast<std::size_t>(static_cast<char const*>(next) -
+                                       string);
+      }
+      std::fill(this->StartSlots.begin(), this->StartSlots.end(), NoPos);
+      this->AddThread(current, 0, this->StartSlots.data(), pos);
+    }
+    if (current.Pcs.empty()) {
+      if (matched || this->Anchored || pos >= this->Length) {
+        break;
+      }
+      ++this->Generation;
+      continue;
+    }
+
+    pending.Pcs.clear();
+    pending.Slots.clear();
+    ++this->Generation;
+    unsigned char const c =
+      pos < this->Length ? static_cast<unsigned char>(string[pos]) : 0;
+    for (std::size_t t = 0; t < current.Pcs.size(); ++t) {
+      std::size_t const pc = current.Pcs[t];
+      std::size_t* threadSlots = current.Slots.data() + t * slots;
+      Instruction const& in = this->Program[pc];
+      bool step = false;
+      switch (in.Op) {
+        case Opcode::Char:
+          step = c == in.Arg;
+          break;
+        case Opcode::Any:
+          step = c != 0;
+          break;
+        case Opcode::Class:
+          step = this->Classes[in.Arg].test(c);
+          break;
+        case Opcode::Match:
+          if (pos != this->Reject) {
+            // Threads after this one have lower priority.
+            this->Result.assign(threadSlots, threadSlots + slots);
+            matched = true;
+            t = current.Pcs.size();
+          }
+          break;
+        default:
+          break;
+      }
+      if (step) {
+        this->AddThread(pending, pc + 1, threadSlots, pos + 1);
+      }
+    }
+    std::swap(current.Pcs, pending.Pcs);
+    std::swap(current.Slots, pending.Slots);
+  }
+  return matched;
+}
+
+std::string::size_type cmLinearRegularExpression::start(int n) const
+{
+  std::size_t const slot = 2 * static_cast<std::size_t>(n);
+  if (slot >= this->Result.size()) {
+    return std::string::npos;
+  }
+  return this->Result[slot];
+}
+
+std::string::size_type cmLinearRegularExpression::end(int n) const
+{
+  std::size_t const slot = 2 * static_cast<std::size_t>(n) + 1;
+  if (slot >= this->Result.size()) {
+    return std::string::npos;
+  }
+  return this->Result[slot];
+}
+
+std::string cmLinearRegularExpression::match(int n) const
+{
+  std::string::size_type const b = this->start(n);
+  std::string::size_type const e = this->end(n);
+  if (b == std::string::npos || e == std::string::npos) {
+    return std::string();
+  }
+  return std::string(this->SearchString + b, e - b);
+}
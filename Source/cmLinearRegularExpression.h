@@ -0,0 +1,115 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <bitset>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/** \class cmLinearRegularExpression
+ * \brief Matches regular expressions in time linear in the input length.
+ *
+ * This accepts the same syntax as cmsys::RegularExpression, reports the
+ * same matches and mirrors the part of its interface used by commands.
+ * Instead of backtracking, all alternatives are followed in lockstep
+ * by simulating the automaton of the expression (a Pike VM), so that
+ * patterns such as "(a|aa)+b" cannot take exponential time.
+ */
+class cmLinearRegularExpression
+{
+public:
+  enum Options
+  {
+    // Match ^ at the offset instead of the beginning of the string.
+    BOL_AT_OFFSET = 1,
+    // Reject an empty match ending at the offset.
+    NONEMPTY_AT_OFFSET = 2,
+  };
+
+  cmLinearRegularExpression() = default;
+  explicit cmLinearRegularExpression(std::string const& pattern);
+
+  /** Compiles a pattern.  Returns false if it is not valid.  */
+  bool compile(std::string const& pattern);
+  bool is_valid() const { return !this->Program.empty(); }
+
+  /**
+   * Finds the leftmost match in the string starting at the offset.  As
+   * with cmsys::RegularExpression, the string ends at its first null
+   * character and must outlive the use of the match results.
+   */
+  bool find(char const* string, std::string::size_type offset = 0,
+            unsigned options = 0);
+  bool find(std::string const& string, std::string::size_type offset = 0,
+            unsigned options = 0)
+  {
+    return this->find(string.c_str(), offset, options);
+  }
+
+  /** Position, end and text of the match or of a subexpression.  */
+  std::string::size_type start(int n = 0) const;
+  std::string::size_type end(int n = 0) const;
+  std::string match(int n = 0) const;
+
+  int num_groups() const { return this->Groups; }
+
+private:
+  enum class Opcode
+  {
+    Char,
+    Any,
+    Class,
+    Bol,
+    Eol,
+    Save,
+    Split,
+    Jump,
+    Match,
+  };
+
+  struct Instruction
+  {
+    Opcode Op;
+    std::size_t Arg;
+    std::size_t Next;
+  };
+
+  struct ThreadList
+  {
+    std::vector<std::size_t> Pcs;
+    std::vector<std::size_t> Slots;
+  };
+
+  class Compiler;
+
+  void AddThread(ThreadList& list, std::size_t pc, std::size_t* slots,
+                 std::size_t pos);
+
+  std::vector<Instruction> Program;
+  std::vector<std::bitset<256>> Classes;
+  int Groups = 0;
+
+  // Literal hints used to skip input that cannot start or hold a match.
+  bool Anchored = false;
+  int FirstChar = -1;
+  std::string Required;
+
+  // Match state.
+  char const* SearchString = nullptr;
+  std::vector<std::size_t> Result;
+
+  // Scratch space reused across searches.
+  char const* Input = nullptr;
+  std::size_t Length = 0;
+  std::size_t Bol = 0;
+  std::size_t Reject = 0;
+  std::size_t Generation = 0;
+  std::vector<std::size_t> Marks;
+  std::vector<std::size_t> Stack;
+  ThreadList Current;
+  ThreadList Pending;
+  std::vector<std::size_t> StartSlots;
+};
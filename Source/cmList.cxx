@@ -21,6 +21,7 @@
 #include "cmGeneratorExpression.h"
 #include "cmListFileCache.h"
 #include "cmRange.h"
+#include "cmRegularExpressionCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmStringReplaceHelper.h"
 #include "cmSystemTools.h"
@@ -59,10 +60,11 @@ cmList& cmList::remove_duplicates()
 }
 
 namespace {
+template <typename RegexType>
 class MatchesRegex
 {
 public:
-  MatchesRegex(cmsys::RegularExpression& regex, cmList::FilterMode mode)
+  MatchesRegex(RegexType& regex, cmList::FilterMode mode)
     : Regex(regex)
     , IncludeMatches(mode == cmList::FilterMode::INCLUDE)
   {
@@ -74,23 +76,38 @@ public:
   }
 
 private:
-  cmsys::RegularExpression& Regex;
+  RegexType& Regex;
   bool const IncludeMatches;
 };
-}
 
-cmList& cmList::filter(cm::string_view pattern, FilterMode mode)
+template <typename Regex>
+void FilterValues(std::vector<std::string>& values, Regex* regex,
+                  cm::string_view pattern, cmList::FilterMode mode)
 {
-  cmsys::RegularExpression regex(std::string{ pattern });
-  if (!regex.is_valid()) {
+  if (!regex) {
     throw std::invalid_argument(
       cmStrCat("sub-command FILTER, mode REGEX failed to compile regex \"",
                pattern, "\"."));
   }
 
-  auto it = std::remove_if(this->Values.begin(), this->Values.end(),
-                           MatchesRegex{ regex, mode });
-  this->Values.erase(it, this->Values.end());
+  auto it = std::remove_if(values.begin(), values.end(),
+                           MatchesRegex<Regex>{ *regex, mode });
+  values.erase(it, values.end());
+}
+}
+
+cmList& cmList::filter(cm::string_view pattern, FilterMode mode,
+                       RegexEngine engine)
+{
+  if (engine == RegexEngine::LINEAR) {
+    FilterValues(this->Values,
+                 cmRegularExpressionCache::GetLinear(std::string{ pattern }),
+                 pattern, mode);
+  } else {
+    FilterValues(this->Values,
+                 cmRegularExpressionCache::Get(std::string{ pattern }),
+                 pattern, mode);
+  }
 
   return *this;
 }
@@ -818,9 +818,15 @@ public:
     INCLUDE,
     EXCLUDE
   };
+  enum class RegexEngine
+  {
+    BACKTRACKING,
+    LINEAR
+  };
   // Includes or removes items from the list
   // Throw std::invalid_argument if regular expression is invalid
-  cmList& filter(cm::string_view regex, FilterMode mode);
+  cmList& filter(cm::string_view regex, FilterMode mode,
+                 RegexEngine engine = RegexEngine::BACKTRACKING);
 
   cmList& reverse()
   {
@@ -3,6 +3,7 @@
 #include "cmListCommand.h"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdio>
 #include <functional>
 #include <set>
@@ -13,15 +14,18 @@
 
 #include <cm/memory>
 #include <cm/optional>
+#include <cm/string_view>
 #include <cmext/algorithm>
 #include <cmext/string_view>
 
+#include "cmDefinitions.h"
 #include "cmExecutionStatus.h"
 #include "cmList.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
+#include "cmRegularExpressionCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmSubcommandTable.h"
 #include "cmValue.h"
@@ -92,6 +96,28 @@ cm::optional<cmList> GetList(std::string const& var,
   return list;
 }
 
+// Reads elements of a list grown by list(APPEND) without parsing it.
+bool GetIndexedItems(cmListDefinition const& list,
+                     std::vector<int> const& indexes,
+                     std::string const& variableName,
+                     cmExecutionStatus& status)
+{
+  auto const size = static_cast<cmList::index_type>(list.GetSize());
+  std::vector<cm::string_view> items;
+  items.reserve(indexes.size());
+  for (int const pos : indexes) {
+    cmList::index_type const index = pos < 0 ? size + pos : pos;
+    if (index < 0 || index >= size) {
+      status.SetError(cmStrCat("index: ", pos, " out of range (-", size,
+                               ", ", size - 1, ')'));
+      return false;
+    }
+    items.push_back(list.GetElement(static_cast<std::size_t>(index)));
+  }
+  status.GetMakefile().AddDefinition(variableName, cmList::to_string(items));
+  return true;
+}
+
 bool HandleLengthCommand(std::vector<std::string> const& args,
                          cmExecutionStatus& status)
 {
@@ -103,9 +129,16 @@ bool HandleLengthCommand(std::vector<std::string> const& args,
   std::string const& listName = args[1];
   std::string const& variableName = args.back();
 
-  auto list = GetList(listName, status.GetMakefile());
-  status.GetMakefile().AddDefinition(variableName,
-                                     std::to_string(list ? list->size() : 0));
+  cmMakefile& makefile = status.GetMakefile();
+  if (cmListDefinition const* indexed =
+        makefile.GetListDefinition(listName)) {
+    makefile.AddDefinition(variableName, std::to_string(indexed->GetSize()));
+    return true;
+  }
+
+  auto list = GetList(listName, makefile);
+  makefile.AddDefinition(variableName,
+                         std::to_string(list ? list->size() : 0));
 
   return true;
 }
@@ -120,14 +153,19 @@ bool HandleGetCommand(std::vector<std::string> const& args,
 
   std::string const& listName = args[1];
   std::string const& variableName = args.back();
-  // expand the variable
-  auto list = GetList(listName, status.GetMakefile());
-  if (!list) {
-    status.GetMakefile().AddDefinition(variableName, "NOTFOUND");
-    return true;
+  cmListDefinition const* indexed =
+    status.GetMakefile().GetListDefinition(listName);
+  cm::optional<cmList> list;
+  if (!indexed) {
+    // expand the variable
+    list = GetList(listName, status.GetMakefile());
+    if (!list) {
+      status.GetMakefile().AddDefinition(variableName, "NOTFOUND");
+      return true;
+    }
   }
   // FIXME: Add policy to make non-existing lists an error like empty lists.
-  if (list->empty()) {
+  if (indexed ? indexed->GetSize() == 0 : list->empty()) {
     status.SetError("GET given empty list");
     return false;
   }
@@ -142,6 +180,10 @@ bool HandleGetCommand(std::vector<std::string> const& args,
     indexes.push_back(index);
   }
 
+  if (indexed) {
+    return GetIndexedItems(*indexed, indexes, variableName, status);
+  }
+
   try {
     auto values = list->get_items(indexes.begin(), indexes.end());
     status.GetMakefile().AddDefinition(variableName, values.to_string());
@@ -162,14 +204,8 @@ bool HandleAppendCommand(std::vector<std::string> const& args,
     return true;
   }
 
-  cmMakefile& makefile = status.GetMakefile();
-  std::string const& listName = args[1];
-  // expand the variable
-  std::string listString;
-  GetListString(listString, listName, makefile);
-
-  makefile.AddDefinition(
-    listName, cmList::append(listString, args.begin() + 2, args.end()));
+  status.GetMakefile().AppendDefinition(
+    args[1], cmList::to_string(cmMakeRange(args).advance(2)));
   return true;
 }
 
@@ -183,14 +219,8 @@ bool HandlePrependCommand(std::vector<std::string> const& args,
     return true;
   }
 
-  cmMakefile& makefile = status.GetMakefile();
-  std::string const& listName = args[1];
-  // expand the variable
-  std::string listString;
-  GetListString(listString, listName, makefile);
-
-  makefile.AddDefinition(
-    listName, cmList::prepend(listString, args.begin() + 2, args.end()));
+  status.GetMakefile().PrependDefinition(
+    args[1], cmList::to_string(cmMakeRange(args).advance(2)));
   return true;
 }
 
@@ -955,10 +985,14 @@ bool HandleFilterCommand(std::vector<std::string> const& args,
     return false;
   }
   std::string const& pattern = args[4];
+  cmList::RegexEngine const engine =
+    cmRegularExpressionCache::UseLinearEngine(status.GetMakefile())
+    ? cmList::RegexEngine::LINEAR
+    : cmList::RegexEngine::BACKTRACKING;
 
   try {
     status.GetMakefile().AddDefinition(
-      listName, list->filter(pattern, filterMode).to_string());
+      listName, list->filter(pattern, filterMode, engine).to_string());
     return true;
   } catch (std::invalid_argument& e) {
     status.SetError(e.what());
@@ -3,6 +3,7 @@
 #define cmListFileCache_cxx
 #include "cmListFileCache.h"
 
+#include <cctype>
 #include <memory>
 #include <ostream>
 #include <utility>
@@ -306,6 +307,10 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
                                    cmListFileArgument::Delimiter delim)
 {
   this->FunctionArguments.emplace_back(token->text, delim, token->line);
+  if (delim != cmListFileArgument::Bracket) {
+    cmListFileArgument& arg = this->FunctionArguments.back();
+    arg.Template = cmListFileArgumentTemplate::Parse(arg.Value);
+  }
   if (this->Separation == SeparationOkay) {
     return true;
   }
@@ -424,6 +429,91 @@ cm::optional<cmListFileContext> cmListFileParser::CheckNesting() const
 
 } // anonymous namespace
 
+std::shared_ptr<cmListFileArgumentTemplate const>
+cmListFileArgumentTemplate::Parse(std::string const& text)
+{
+  // This follows cmMakefile::ExpandVariablesInStringImpl for the syntax
+  // whose meaning does not depend on the values of variables.
+  if (text.find_first_of("$\\") == std::string::npos) {
+    return nullptr;
+  }
+
+  auto result = std::make_shared<cmListFileArgumentTemplate>();
+  std::string literal;
+  std::string::size_type pos = 0;
+  while (pos < text.size()) {
+    char const c = text[pos];
+    if (c == '\\') {
+      if (pos + 1 == text.size()) {
+        return nullptr;
+      }
+      char const next = text[pos + 1];
+      if (next == 't') {
+        literal += '\t';
+      } else if (next == 'n') {
+        literal += '\n';
+      } else if (next == 'r') {
+        literal += '\r';
+      } else if (next == ';') {
+        // Handled when the argument is split into a list.
+        literal += "\\;";
+      } else if (isalnum(next)) {
+        return nullptr;
+      } else {
+        literal += next;
+      }
+      pos += 2;
+      continue;
+    }
+    if (c != '$') {
+      literal += c;
+      ++pos;
+      continue;
+    }
+
+    SegmentKind kind;
+    std::string::size_type start;
+    if (text.compare(pos + 1, 1, "{") == 0) {
+      kind = Variable;
+      start = pos + 2;
+    } else if (text.compare(pos + 1, 4, "ENV{") == 0) {
+      kind = EnvironmentVariable;
+      start = pos + 5;
+    } else if (text.compare(pos + 1, 6, "CACHE{") == 0) {
+      kind = CacheVariable;
+      start = pos + 7;
+    } else if (pos + 1 == text.size() || text[pos + 1] == '<') {
+      literal += c;
+      ++pos;
+      continue;
+    } else {
+      return nullptr;
+    }
+    std::string::size_type const end =
+      text.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                             "abcdefghijklmnopqrstuvwxyz"
+                             "0123456789/_.+-",
+                             start);
+    if (end == std::string::npos || text[end] != '}') {
+      return nullptr;
+    }
+    std::string name = text.substr(start, end - start);
+    if (kind == Variable && name == "CMAKE_CURRENT_LIST_LINE") {
+      return nullptr;
+    }
+    if (!literal.empty()) {
+      result->Segments.push_back({ Literal, std::move(literal) });
+      literal.clear();
+    }
+    result->Segments.push_back({ kind, std::move(name) });
+    pos = end + 1;
+  }
+  if (!literal.empty()) {
+    result->Segments.push_back({ Literal, std::move(literal) });
+  }
+  return result;
+}
+
 bool cmListFile::ParseFile(char const* filename, cmMessenger* messenger,
                            cmListFileBacktrace const& lfbt)
 {
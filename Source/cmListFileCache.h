@@ -25,6 +25,42 @@
 
 class cmMessenger;
 
+/** \class cmListFileArgumentTemplate
+ * \brief Literal text and variable references of a listfile argument.
+ *
+ * The parser prepares this once for each argument that references
+ * variables or contains escape sequences, so evaluating the argument
+ * concatenates the segments instead of scanning its text again.
+ */
+struct cmListFileArgumentTemplate
+{
+  enum SegmentKind
+  {
+    Literal,
+    Variable,
+    EnvironmentVariable,
+    CacheVariable
+  };
+  struct Segment
+  {
+    SegmentKind Kind;
+    // The literal text with escape sequences replaced, or the name of
+    // the variable.
+    std::string Text;
+  };
+
+  /**
+   * Splits the text of an unquoted or quoted argument into segments.
+   * Returns nullptr if the text has nothing to expand, or uses syntax
+   * left to cmMakefile::ExpandVariablesInString: nested references,
+   * ${CMAKE_CURRENT_LIST_LINE}, and errors.
+   */
+  static std::shared_ptr<cmListFileArgumentTemplate const> Parse(
+    std::string const& text);
+
+  std::vector<Segment> Segments;
+};
+
 struct cmListFileArgument
 {
   enum Delimiter
@@ -48,6 +84,9 @@ struct cmListFileArgument
   std::string Value;
   Delimiter Delim = Unquoted;
   long Line = 0;
+  // Set by the parser.  Code that builds or changes arguments leaves it
+  // empty to get the general expansion.
+  std::shared_ptr<cmListFileArgumentTemplate const> Template;
 };
 
 class cmListFileFunction
@@ -115,6 +115,10 @@ void cmLocalNinjaGenerator::Generate()
     if (!target->IsInBuildSystem()) {
       continue;
     }
+#if !defined(CMAKE_BOOTSTRAP)
+    auto profilingRAII = this->GetCMakeInstance()->CreateProfilingEntry(
+      "generate_target", target->GetName());
+#endif
     auto tg = cmNinjaTargetGenerator::New(target.get());
     if (tg) {
       if (target->Target->IsPerConfig()) {
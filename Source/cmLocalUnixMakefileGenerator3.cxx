@@ -177,6 +177,11 @@ void cmLocalUnixMakefileGenerator3::Generate()
       continue;
     }
 
+#if !defined(CMAKE_BOOTSTRAP)
+    auto profilingRAII = this->GetCMakeInstance()->CreateProfilingEntry(
+      "generate_target", gt->GetName());
+#endif
+
     auto& gtVisited = this->GetCommandsVisited(gt);
     auto const& deps = this->GlobalGenerator->GetTargetDirectDepends(gt);
     for (auto const& d : deps) {
@@ -832,8 +837,8 @@ void cmLocalUnixMakefileGenerator3::WriteSpecialTargetsBottom(
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
-                 this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+        cmStrCat("$(CMAKE_COMMAND) -E cmake_verify_globs ",
+                 this->ConvertToOutputFormat(cm->GetGlobVerifyData(),
                                              cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
     }
@@ -1839,8 +1844,8 @@ void cmLocalUnixMakefileGenerator3::WriteLocalAllRules(
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
-                 this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
+        cmStrCat("$(CMAKE_COMMAND) -E cmake_verify_globs ",
+                 this->ConvertToOutputFormat(cm->GetGlobVerifyData(),
                                              cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
     }
@@ -2,9 +2,11 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmMacroCommand.h"
 
+#include <cstddef>
 #include <utility>
 
 #include <cm/memory>
+#include <cm/optional>
 #include <cm/string_view>
 #include <cmext/algorithm>
 #include <cmext/string_view>
@@ -35,10 +37,33 @@ public:
 
   std::vector<std::string> Args;
   std::vector<cmListFileFunction> Functions;
+  // Whether each of the Functions refers to the macro arguments and
+  // must be rewritten for every invocation.
+  std::vector<bool> ReferencesArgs;
   cmPolicies::PolicyMap Policies;
   std::string FilePath;
 };
 
+bool ReferencesMacroArgs(cmListFileFunction const& func,
+                         std::vector<std::string> const& args)
+{
+  for (cmListFileArgument const& k : func.Arguments()) {
+    if (k.Delim == cmListFileArgument::Bracket) {
+      continue;
+    }
+    // This covers ARGC, ARGN, ARGV and ARGV#.
+    if (k.Value.find("${ARG") != std::string::npos) {
+      return true;
+    }
+    for (unsigned int j = 1; j < args.size(); ++j) {
+      if (k.Value.find(cmStrCat("${", args[j], '}')) != std::string::npos) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool cmMacroHelperCommand::operator()(
   std::vector<cmListFileArgument> const& args,
   cmExecutionStatus& inStatus) const
@@ -81,43 +106,49 @@ bool cmMacroHelperCommand::operator()(
   }
   // Invoke all the functions that were collected in the block.
   // for each function
-  for (cmListFileFunction const& func : this->Functions) {
-    // Replace the formal arguments and then invoke the command.
-    std::vector<cmListFileArgument> newLFFArgs;
-    newLFFArgs.reserve(func.Arguments().size());
-
-    // for each argument of the current function
-    for (cmListFileArgument const& k : func.Arguments()) {
-      cmListFileArgument arg;
-      arg.Value = k.Value;
-      if (k.Delim != cmListFileArgument::Bracket) {
-        // replace formal arguments
-        for (unsigned int j = 0; j < variables.size(); ++j) {
-          cmSystemTools::ReplaceString(arg.Value, variables[j],
-                                       expandedArgs[j]);
-        }
-        // replace argc
-        cmSystemTools::ReplaceString(arg.Value, "${ARGC}", argcDef);
-
-        cmSystemTools::ReplaceString(arg.Value, "${ARGN}", expandedArgn);
-        cmSystemTools::ReplaceString(arg.Value, "${ARGV}", expandedArgv);
-
-        // if the current argument of the current function has ${ARGV in it
-        // then try replacing ARGV values
-        if (arg.Value.find("${ARGV") != std::string::npos) {
-          for (unsigned int t = 0; t < expandedArgs.size(); ++t) {
-            cmSystemTools::ReplaceString(arg.Value, argVs[t], expandedArgs[t]);
+  for (std::size_t i = 0; i < this->Functions.size(); ++i) {
+    cmListFileFunction const& func = this->Functions[i];
+    cm::optional<cmListFileFunction> newLFF;
+    if (this->ReferencesArgs[i]) {
+      // Replace the formal arguments and then invoke the command.
+      std::vector<cmListFileArgument> newLFFArgs;
+      newLFFArgs.reserve(func.Arguments().size());
+
+      // for each argument of the current function
+      for (cmListFileArgument const& k : func.Arguments()) {
+        cmListFileArgument arg;
+        arg.Value = k.Value;
+        if (k.Delim != cmListFileArgument::Bracket) {
+          // replace formal arguments
+          for (unsigned int j = 0; j < variables.size(); ++j) {
+            cmSystemTools::ReplaceString(arg.Value, variables[j],
+                                         expandedArgs[j]);
+          }
+          // replace argc
+          cmSystemTools::ReplaceString(arg.Value, "${ARGC}", argcDef);
+
+          cmSystemTools::ReplaceString(arg.Value, "${ARGN}", expandedArgn);
+          cmSystemTools::ReplaceString(arg.Value, "${ARGV}", expandedArgv);
+
+          // if the current argument of the current function has ${ARGV in
+          // it then try replacing ARGV values
+          if (arg.Value.find("${ARGV") != std::string::npos) {
+            for (unsigned int t = 0; t < expandedArgs.size(); ++t) {
+              cmSystemTools::ReplaceString(arg.Value, argVs[t],
+                                           expandedArgs[t]);
+            }
           }
         }
+        arg.Delim = k.Delim;
+        arg.Line = k.Line;
+        newLFFArgs.push_back(std::move(arg));
       }
-      arg.Delim = k.Delim;
-      arg.Line = k.Line;
-      newLFFArgs.push_back(std::move(arg));
+      newLFF.emplace(func.OriginalName(), func.Line(), func.LineEnd(),
+                     std::move(newLFFArgs));
     }
-    cmListFileFunction newLFF{ func.OriginalName(), func.Line(),
-                               func.LineEnd(), std::move(newLFFArgs) };
     cmExecutionStatus status(makefile);
-    if (!makefile.ExecuteCommand(newLFF, status) || status.GetNestedError()) {
+    if (!makefile.ExecuteCommand(newLFF ? *newLFF : func, status) ||
+        status.GetNestedError()) {
       // The error message should have already included the call stack
       // so we do not need to report an error here.
       macroScope.Quiet();
@@ -172,6 +203,10 @@ bool cmMacroFunctionBlocker::Replay(std::vector<cmListFileFunction> functions,
   cmMacroHelperCommand f;
   f.Args = this->Args;
   f.Functions = std::move(functions);
+  f.ReferencesArgs.reserve(f.Functions.size());
+  for (cmListFileFunction const& func : f.Functions) {
+    f.ReferencesArgs.push_back(ReferencesMacroArgs(func, f.Args));
+  }
   f.FilePath = this->GetStartingContext().FilePath;
   mf.RecordPolicies(f.Policies);
   return mf.GetState()->AddScriptedCommand(
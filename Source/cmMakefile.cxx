@@ -32,6 +32,7 @@
 #include "cmCustomCommand.h"
 #include "cmCustomCommandLines.h"
 #include "cmCustomCommandTypes.h"
+#include "cmDefinitions.h"
 #include "cmExecutionStatus.h"
 #include "cmExpandedCommandArgument.h" // IWYU pragma: keep
 #include "cmExportBuildFileGenerator.h"
@@ -43,6 +44,7 @@
 #include "cmGlobalGenerator.h"
 #include "cmInstallGenerator.h" // IWYU pragma: keep
 #include "cmInstallSubdirectoryGenerator.h"
+#include "cmLinearRegularExpression.h"
 #include "cmList.h"
 #include "cmListFileCache.h"
 #include "cmLocalGenerator.h"
@@ -1836,6 +1838,48 @@ void cmMakefile::AddDefinitionBool(std::string const& name, bool value)
   this->AddDefinition(name, value ? "ON" : "OFF");
 }
 
+void cmMakefile::AppendDefinition(std::string const& name,
+                                  cm::string_view elements)
+{
+  this->AddListDefinitionElements(name, elements, false);
+}
+
+void cmMakefile::PrependDefinition(std::string const& name,
+                                   cm::string_view elements)
+{
+  this->AddListDefinitionElements(name, elements, true);
+}
+
+void cmMakefile::AddListDefinitionElements(std::string const& name,
+                                           cm::string_view elements,
+                                           bool atStart)
+{
+  // The old value may come from the cache, and watches see it read.
+  cmValue const oldValue = this->GetDefinition(name);
+  bool const grown = atStart
+    ? this->StateSnapshot.PrependDefinition(name, elements)
+    : this->StateSnapshot.AppendDefinition(name, elements);
+  if (!grown) {
+    std::string value = *oldValue;
+    if (atStart) {
+      cmList::prepend(value, elements);
+    } else {
+      cmList::append(value, elements);
+    }
+    this->AddDefinition(name, value);
+    return;
+  }
+
+#ifndef CMAKE_BOOTSTRAP
+  cmVariableWatch* vv = this->GetVariableWatch();
+  if (vv) {
+    vv->VariableAccessed(name, cmVariableWatch::VARIABLE_MODIFIED_ACCESS,
+                         this->StateSnapshot.GetDefinition(name).GetCStr(),
+                         this);
+  }
+#endif
+}
+
 void cmMakefile::AddCacheDefinition(std::string const& name, cmValue value,
                                     cmValue doc,
                                     cmStateEnums::CacheEntryType type,
@@ -2406,6 +2450,20 @@ cmValue cmMakefile::GetDefinition(std::string const& name) const
   return def;
 }
 
+cmListDefinition const* cmMakefile::GetListDefinition(
+  std::string const& name) const
+{
+#ifndef CMAKE_BOOTSTRAP
+  // Let GetDefinition() tell the watches that the value is read.
+  cmVariableWatch* vv = this->GetVariableWatch();
+  if (vv && vv->IsWatched(name)) {
+    return nullptr;
+  }
+#endif
+  cmListDefinition const* list = this->StateSnapshot.GetListDefinition(name);
+  return list && list->IsIndexed() ? list : nullptr;
+}
+
 std::string const& cmMakefile::GetSafeDefinition(std::string const& name) const
 {
   return this->GetDefinition(name);
@@ -2475,15 +2533,16 @@ bool cmMakefile::IsProjectFile(char const* filename) const
 
 size_t cmMakefile::GetRecursionDepthLimit() const
 {
+  // This is checked for every command, so avoid building the name.
+  static std::string const depthVar = "CMAKE_MAXIMUM_RECURSION_DEPTH";
   size_t depth = CMake_DEFAULT_RECURSION_LIMIT;
-  if (cmValue depthStr =
-        this->GetDefinition("CMAKE_MAXIMUM_RECURSION_DEPTH")) {
+  if (cmValue depthStr = this->GetDefinition(depthVar)) {
     unsigned long depthUL;
     if (cmStrToULong(depthStr.GetCStr(), &depthUL)) {
       depth = depthUL;
     }
   } else if (cm::optional<std::string> depthEnv =
-               cmSystemTools::GetEnvVar("CMAKE_MAXIMUM_RECURSION_DEPTH")) {
+               cmSystemTools::GetEnvVar(depthVar)) {
     unsigned long depthUL;
     if (cmStrToULong(*depthEnv, &depthUL)) {
       depth = depthUL;
@@ -2797,7 +2856,7 @@ MessageType cmMakefile::ExpandVariablesInStringImpl(
     // Append the rest of the unchanged part of the string.
     result.append(last);
 
-    source = result;
+    source = std::move(result);
   }
 
   return mtype;
@@ -2943,11 +3002,89 @@ bool cmMakefile::IsLoopBlock() const
   return !this->LoopBlockCounter.empty() && this->LoopBlockCounter.top() > 0;
 }
 
+std::string const* cmMakefile::ExpandArgument(cmListFileArgument const& arg,
+                                              std::string const& filename,
+                                              std::string& buffer) const
+{
+  // Most arguments are either plain words or a single variable
+  // reference.  Their value is known without copying them.
+  std::string const& text = arg.Value;
+  if (text.find_first_of("$\\") == std::string::npos) {
+    return &text;
+  }
+
+  if (arg.Template) {
+    // The parser already split the argument into literal text and
+    // variable references.
+    auto const& segments = arg.Template->Segments;
+    if (segments.size() == 1 &&
+        segments[0].Kind == cmListFileArgumentTemplate::Variable) {
+      cmValue const value = this->GetDefinition(segments[0].Text);
+      if (!value) {
+        this->MaybeWarnUninitialized(segments[0].Text, filename.c_str());
+      }
+      return &*value;
+    }
+    buffer.clear();
+    std::string env;
+    for (cmListFileArgumentTemplate::Segment const& segment : segments) {
+      cmValue value;
+      switch (segment.Kind) {
+        case cmListFileArgumentTemplate::Literal:
+          buffer += segment.Text;
+          continue;
+        case cmListFileArgumentTemplate::Variable:
+          value = this->GetDefinition(segment.Text);
+          break;
+        case cmListFileArgumentTemplate::EnvironmentVariable:
+          if (cmSystemTools::GetEnv(segment.Text, env)) {
+            value = cmValue(env);
+          }
+          break;
+        case cmListFileArgumentTemplate::CacheVariable:
+          value = this->GetState()->GetCacheEntryValue(segment.Text);
+          break;
+      }
+      if (value) {
+        buffer += *value;
+      } else {
+        this->MaybeWarnUninitialized(segment.Text, filename.c_str());
+      }
+    }
+    return &buffer;
+  }
+
+  // Arguments not read by the parser, such as those of macro calls,
+  // have no template.
+  if (text.size() >= 4 && text[0] == '$' && text[1] == '{' &&
+      text.back() == '}') {
+    cm::string_view const name =
+      cm::string_view(text).substr(2, text.size() - 3);
+    if (name.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                               "abcdefghijklmnopqrstuvwxyz"
+                               "0123456789/_.+-") == cm::string_view::npos &&
+        name != "CMAKE_CURRENT_LIST_LINE"_s) {
+      std::string const variable(name);
+      cmValue const value = this->GetDefinition(variable);
+      if (!value) {
+        this->MaybeWarnUninitialized(variable, filename.c_str());
+      }
+      return &*value;
+    }
+  }
+
+  // Expand the variables in the argument.
+  buffer = text;
+  this->ExpandVariablesInString(buffer, false, false, false, filename.c_str(),
+                                arg.Line, false, false);
+  return &buffer;
+}
+
 bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
                                  std::vector<std::string>& outArgs) const
 {
   std::string const& filename = this->GetBacktrace().Top().FilePath;
-  std::string value;
+  std::string buffer;
   outArgs.reserve(inArgs.size());
   for (cmListFileArgument const& i : inArgs) {
     // No expansion in a bracket argument.
@@ -2955,17 +3092,14 @@ bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
       outArgs.push_back(i.Value);
       continue;
     }
-    // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    std::string const* expanded = this->ExpandArgument(i, filename, buffer);
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.push_back(value);
+      outArgs.push_back(*expanded);
     } else {
-      cmExpandList(value, outArgs);
+      cmExpandList(*expanded, outArgs);
     }
   }
   return !cmSystemTools::GetFatalErrorOccurred();
@@ -2976,7 +3110,7 @@ bool cmMakefile::ExpandArguments(
   std::vector<cmExpandedCommandArgument>& outArgs) const
 {
   std::string const& filename = this->GetBacktrace().Top().FilePath;
-  std::string value;
+  std::string buffer;
   outArgs.reserve(inArgs.size());
   for (cmListFileArgument const& i : inArgs) {
     // No expansion in a bracket argument.
@@ -2984,19 +3118,16 @@ bool cmMakefile::ExpandArguments(
       outArgs.emplace_back(i.Value, true);
       continue;
     }
-    // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    std::string const* expanded = this->ExpandArgument(i, filename, buffer);
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.emplace_back(value, true);
+      outArgs.emplace_back(*expanded, true);
     } else {
-      cmList stringArgs{ value };
-      for (std::string const& stringArg : stringArgs) {
-        outArgs.emplace_back(stringArg, false);
+      cmList stringArgs{ *expanded };
+      for (std::string& stringArg : stringArgs) {
+        outArgs.emplace_back(std::move(stringArg), false);
       }
     }
   }
@@ -4014,21 +4145,34 @@ void cmMakefile::ClearMatches()
   this->MarkVariableAsUsed(nMatchesVariable);
 }
 
-void cmMakefile::StoreMatches(cmsys::RegularExpression& re)
+namespace {
+template <typename Regex>
+void StoreRegexMatches(cmMakefile& mf, Regex& re)
 {
   char highest = 0;
   for (int i = 0; i < 10; i++) {
     std::string const& m = re.match(i);
     if (!m.empty()) {
       std::string const& var = matchVariables[i];
-      this->AddDefinition(var, m);
-      this->MarkVariableAsUsed(var);
+      mf.AddDefinition(var, m);
+      mf.MarkVariableAsUsed(var);
       highest = static_cast<char>('0' + i);
     }
   }
   char nMatches[] = { highest, '\0' };
-  this->AddDefinition(nMatchesVariable, nMatches);
-  this->MarkVariableAsUsed(nMatchesVariable);
+  mf.AddDefinition(nMatchesVariable, nMatches);
+  mf.MarkVariableAsUsed(nMatchesVariable);
+}
+}
+
+void cmMakefile::StoreMatches(cmsys::RegularExpression& re)
+{
+  StoreRegexMatches(*this, re);
+}
+
+void cmMakefile::StoreMatches(cmLinearRegularExpression& re)
+{
+  StoreRegexMatches(*this, re);
 }
 
 cmStateSnapshot cmMakefile::GetStateSnapshot() const
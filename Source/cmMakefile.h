@@ -55,6 +55,8 @@ class cmExportBuildFileGenerator;
 class cmGeneratorExpressionEvaluationFile;
 class cmGlobalGenerator;
 class cmInstallGenerator;
+class cmLinearRegularExpression;
+class cmListDefinition;
 class cmLocalGenerator;
 class cmMessenger;
 class cmSourceFile;
@@ -319,6 +321,13 @@ public:
    * Add bool variable definition to the build.
    */
   void AddDefinitionBool(std::string const& name, bool);
+  /**
+   * Add list elements at the end or at the start of a variable, as
+   * list(APPEND) and list(PREPEND) do.  A variable of the current
+   * scope that is only appended to is grown in place.
+   */
+  void AppendDefinition(std::string const& name, cm::string_view elements);
+  void PrependDefinition(std::string const& name, cm::string_view elements);
   //! Add a definition to this makefile and the global cmake cache.
   void AddCacheDefinition(std::string const& name, cmValue value, cmValue doc,
                           cmStateEnums::CacheEntryType type,
@@ -539,6 +548,12 @@ public:
   cmValue GetDefinition(std::string const&) const;
   std::string const& GetSafeDefinition(std::string const&) const;
   std::string const& GetRequiredDefinition(std::string const& name) const;
+  /**
+   * Returns the value of a variable grown by AppendDefinition() or
+   * PrependDefinition() if its elements are indexed.  Returns nullptr
+   * if the value must be read with GetDefinition() and parsed instead.
+   */
+  cmListDefinition const* GetListDefinition(std::string const& name) const;
   bool IsDefinitionSet(std::string const&) const;
   bool IsNormalDefinitionSet(std::string const&) const;
   /**
@@ -1008,6 +1023,7 @@ public:
 
   void ClearMatches();
   void StoreMatches(cmsys::RegularExpression& re);
+  void StoreMatches(cmLinearRegularExpression& re);
 
   cmStateSnapshot GetStateSnapshot() const;
 
@@ -1083,6 +1099,9 @@ public:
                         cm::optional<std::string> const& rootENV);
   void MaybeWarnUninitialized(std::string const& variable,
                               char const* sourceFilename) const;
+  std::string const* ExpandArgument(cmListFileArgument const& arg,
+                                    std::string const& filename,
+                                    std::string& buffer) const;
   bool IsProjectFile(char const* filename) const;
 
   size_t GetRecursionDepthLimit() const;
@@ -1173,6 +1192,9 @@ private:
 
   bool ParseDefineFlag(std::string const& definition, bool remove);
 
+  void AddListDefinitionElements(std::string const& name,
+                                 cm::string_view elements, bool atStart);
+
   bool EnforceUniqueDir(std::string const& srcPath,
                         std::string const& binPath) const;
 
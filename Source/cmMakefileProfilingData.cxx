@@ -12,11 +12,24 @@
 #include "cmsys/FStream.hxx"
 #include "cmsys/SystemInformation.hxx"
 
+#include "cmRegularExpressionCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+namespace {
+std::uint64_t NowMicroseconds()
+{
+  return static_cast<std::uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+}
+}
+
 cmMakefileProfilingData::cmMakefileProfilingData(
-  std::string const& profileStream)
+  std::string const& profileStream, Format format, bool trackMemory)
+  : OutputFormat(format)
+  , TrackMemory(trackMemory)
 {
   std::ios::openmode omode = std::ios::out | std::ios::trunc;
   this->ProfileStream.open(profileStream.c_str(), omode);
@@ -27,14 +40,26 @@ cmMakefileProfilingData::cmMakefileProfilingData(
     throw std::runtime_error(std::string("Unable to open: ") + profileStream);
   }
 
-  this->ProfileStream << "[";
+  if (this->OutputFormat == Format::GoogleTrace) {
+    this->ProfileStream << "[";
+  }
+
+  if (this->TrackMemory) {
+    cmsys::SystemInformation info;
+    this->LastMemory = info.GetProcMemoryUsed();
+  }
 }
 
 cmMakefileProfilingData::~cmMakefileProfilingData() noexcept
 {
   if (this->ProfileStream.good()) {
     try {
-      this->ProfileStream << "]";
+      if (this->OutputFormat == Format::FoldedStack) {
+        this->WriteFoldedStacks();
+      } else {
+        this->WriteRegexCacheStatistics();
+        this->ProfileStream << "]";
+      }
       this->ProfileStream.close();
     } catch (...) {
       cmSystemTools::Error("Error writing profiling output!");
@@ -51,6 +76,15 @@ void cmMakefileProfilingData::StartEntry(std::string const& category,
     return;
   }
 
+  if (this->TrackMemory) {
+    this->SampleMemory();
+  }
+
+  if (this->OutputFormat == Format::FoldedStack) {
+    this->StartFoldedEntry(category, name, args);
+    return;
+  }
+
   try {
     if (this->ProfileStream.tellp() > 1) {
       this->ProfileStream << ",";
@@ -86,6 +120,15 @@ void cmMakefileProfilingData::StopEntry()
     return;
   }
 
+  if (this->TrackMemory) {
+    this->SampleMemory();
+  }
+
+  if (this->OutputFormat == Format::FoldedStack) {
+    this->StopFoldedEntry();
+    return;
+  }
+
   try {
     this->ProfileStream << ",";
     cmsys::SystemInformation info;
@@ -106,6 +149,132 @@ void cmMakefileProfilingData::StopEntry()
   }
 }
 
+void cmMakefileProfilingData::StartFoldedEntry(
+  std::string const& category, std::string const& name,
+  cm::optional<Json::Value> const& args)
+{
+  // Frames are separated by ';' and a line ends with a space and the
+  // sample count, so keep each frame on one line without separators.
+  std::string frame = cmStrCat(category, ':', name);
+  if (args && args->isObject() && (*args)["location"].isString()) {
+    frame = cmStrCat(frame, " (", (*args)["location"].asString(), ')');
+  }
+  for (char& c : frame) {
+    if (c == ';') {
+      c = ',';
+    } else if (c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+
+  FoldedFrame entry;
+  entry.Stack = this->FoldedFrames.empty()
+    ? std::move(frame)
+    : cmStrCat(this->FoldedFrames.back().Stack, ';', frame);
+  entry.Start = NowMicroseconds();
+  entry.ChildTime = 0;
+  this->FoldedFrames.emplace_back(std::move(entry));
+}
+
+void cmMakefileProfilingData::StopFoldedEntry()
+{
+  if (this->FoldedFrames.empty()) {
+    return;
+  }
+
+  FoldedFrame& entry = this->FoldedFrames.back();
+  std::uint64_t const elapsed = NowMicroseconds() - entry.Start;
+  std::uint64_t const self =
+    elapsed > entry.ChildTime ? elapsed - entry.ChildTime : 0;
+  this->FoldedStacks[entry.Stack] += self;
+  this->FoldedFrames.pop_back();
+  if (!this->FoldedFrames.empty()) {
+    this->FoldedFrames.back().ChildTime += elapsed;
+  }
+}
+
+void cmMakefileProfilingData::WriteFoldedStacks()
+{
+  // Close entries still open, such as those of a fatal error unwinding.
+  while (!this->FoldedFrames.empty()) {
+    this->StopFoldedEntry();
+  }
+
+  // With memory tracking the samples are the growth of the resident
+  // memory, in KiB, observed while each stack was innermost.
+  auto const& stacks =
+    this->TrackMemory ? this->FoldedMemory : this->FoldedStacks;
+  for (auto const& stack : stacks) {
+    if (this->TrackMemory && stack.second == 0) {
+      continue;
+    }
+    this->ProfileStream << stack.first << ' ' << stack.second << '\n';
+  }
+}
+
+void cmMakefileProfilingData::SampleMemory()
+{
+  cmsys::SystemInformation info;
+  long long const memory = info.GetProcMemoryUsed();
+  if (memory == this->LastMemory) {
+    return;
+  }
+
+  if (this->OutputFormat == Format::FoldedStack) {
+    // Attribute growth to the entry that was running since the last
+    // sample, excluding the entries it called.
+    if (memory > this->LastMemory && !this->FoldedFrames.empty()) {
+      this->FoldedMemory[this->FoldedFrames.back().Stack] +=
+        static_cast<std::uint64_t>(memory - this->LastMemory);
+    }
+  } else {
+    // Record a counter event so trace viewers graph the memory usage
+    // along the entries.
+    try {
+      if (this->ProfileStream.tellp() > 1) {
+        this->ProfileStream << ",";
+      }
+      Json::Value v;
+      v["ph"] = "C";
+      v["name"] = "memory";
+      v["ts"] = static_cast<Json::Value::UInt64>(NowMicroseconds());
+      v["pid"] = static_cast<int>(info.GetProcessId());
+      v["tid"] = 0;
+      v["args"]["resident_kib"] = static_cast<Json::Value::Int64>(memory);
+      this->JsonWriter->write(v, &this->ProfileStream);
+    } catch (std::ios_base::failure& fail) {
+      cmSystemTools::Error(
+        cmStrCat("Failed to write to profiling output: ", fail.what()));
+    } catch (...) {
+      cmSystemTools::Error("Error writing profiling output!");
+    }
+  }
+  this->LastMemory = memory;
+}
+
+void cmMakefileProfilingData::WriteRegexCacheStatistics()
+{
+  // Record how often commands found their regular expression already
+  // compiled.
+  cmRegularExpressionCache::Statistics const stats =
+    cmRegularExpressionCache::GetStatistics();
+  if (this->ProfileStream.tellp() > 1) {
+    this->ProfileStream << ",";
+  }
+  cmsys::SystemInformation info;
+  Json::Value v;
+  v["ph"] = "C";
+  v["name"] = "regex_cache";
+  v["ts"] = static_cast<Json::Value::UInt64>(NowMicroseconds());
+  v["pid"] = static_cast<int>(info.GetProcessId());
+  v["tid"] = 0;
+  v["args"]["hits"] = static_cast<Json::Value::UInt64>(stats.Hits);
+  v["args"]["misses"] = static_cast<Json::Value::UInt64>(stats.Misses);
+  v["args"]["evictions"] = static_cast<Json::Value::UInt64>(stats.Evictions);
+  v["args"]["size"] = static_cast<Json::Value::UInt64>(stats.Size);
+  this->JsonWriter->write(v, &this->ProfileStream);
+}
+
 cmMakefileProfilingData::RAII::RAII(cmMakefileProfilingData& data,
                                     std::string const& category,
                                     std::string const& name,
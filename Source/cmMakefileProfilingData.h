@@ -1,8 +1,11 @@
 /* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #pragma once
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <cm/optional>
 
@@ -17,7 +20,18 @@ class StreamWriter;
 class cmMakefileProfilingData
 {
 public:
-  cmMakefileProfilingData(std::string const&);
+  enum class Format
+  {
+    // Begin and end events in the Google Trace Event Format.
+    GoogleTrace,
+    // Self time of each distinct stack of entries, one stack per line,
+    // as consumed by flame graph tools.
+    FoldedStack,
+  };
+
+  cmMakefileProfilingData(std::string const&,
+                          Format format = Format::GoogleTrace,
+                          bool trackMemory = false);
   ~cmMakefileProfilingData() noexcept;
   void StartEntry(std::string const& category, std::string const& name,
                   cm::optional<Json::Value> args = cm::nullopt);
@@ -44,6 +58,26 @@ public:
   };
 
 private:
+  void StartFoldedEntry(std::string const& category, std::string const& name,
+                        cm::optional<Json::Value> const& args);
+  void StopFoldedEntry();
+  void WriteFoldedStacks();
+  void WriteRegexCacheStatistics();
+  void SampleMemory();
+
+  Format OutputFormat;
+  bool TrackMemory;
+  long long LastMemory = 0;
   cmsys::ofstream ProfileStream;
   std::unique_ptr<Json::StreamWriter> JsonWriter;
+
+  struct FoldedFrame
+  {
+    std::string Stack;
+    std::uint64_t Start;
+    std::uint64_t ChildTime;
+  };
+  std::vector<FoldedFrame> FoldedFrames;
+  std::map<std::string, std::uint64_t> FoldedStacks;
+  std::map<std::string, std::uint64_t> FoldedMemory;
 };
@@ -4,9 +4,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <sstream>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <cm/memory>
@@ -84,8 +86,7 @@ public:
     for (std::string const& dir : this->OD->OriginalDirectories) {
       // Check if this directory conflicts with the entry.
       if (dir != this->Directory &&
-          cmSystemTools::GetRealPath(dir) !=
-            cmSystemTools::GetRealPath(this->Directory) &&
+          !this->OD->IsSameDirectory(dir, this->Directory) &&
           this->FindConflict(dir)) {
         // The library will be found in this directory but it is
         // supposed to be found in an implicit search directory.
@@ -120,7 +121,20 @@ protected:
 bool cmOrderDirectoriesConstraint::FileMayConflict(std::string const& dir,
                                                    std::string const& name)
 {
-  // Check if the file exists on disk.
+  // Look for the file in the directory listing, which also includes
+  // the files that will be built by cmake.  The listing is shared by
+  // all targets so only names it contains need to be checked on disk.
+  std::set<std::string> const& files =
+    this->GlobalGenerator->GetLinkDirectoryContent(dir);
+  bool const listed = files.find(name) != files.end();
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(__CYGWIN__)
+  if (!listed) {
+    return false;
+  }
+#endif
+
+  // Check if the file exists on disk.  File systems that ignore case
+  // also find names the listing does not contain.
   std::string file = cmStrCat(dir, '/', name);
   if (cmSystemTools::FileExists(file, true)) {
     // The file conflicts only if it is not the same as the original
@@ -129,10 +143,7 @@ bool cmOrderDirectoriesConstraint::FileMayConflict(std::string const& dir,
   }
 
   // Check if the file will be built by cmake.
-  std::set<std::string> const& files =
-    (this->GlobalGenerator->GetDirectoryContent(dir, false));
-  auto fi = files.find(name);
-  return fi != files.end();
+  return listed;
 }
 
 class cmOrderDirectoriesConstraintSOName : public cmOrderDirectoriesConstraint
@@ -183,7 +194,7 @@ bool cmOrderDirectoriesConstraintSOName::FindConflict(std::string const& dir)
     // We do not have the soname.  Look for files in the directory
     // that may conflict.
     std::set<std::string> const& files =
-      (this->GlobalGenerator->GetDirectoryContent(dir, true));
+      this->GlobalGenerator->GetLinkDirectoryContent(dir);
 
     // Get the set of files that might conflict.  Since we do not
     // know the soname just look at all files that start with the
@@ -493,28 +504,41 @@ void cmOrderDirectories::OrderDirectories()
 
 void cmOrderDirectories::VisitDirectory(unsigned int i)
 {
-  // Skip nodes already visited.
-  if (this->DirectoryVisited[i]) {
-    if (this->DirectoryVisited[i] == this->WalkId) {
-      // We have reached a node previously visited on this DFS.
-      // There is a cycle.
-      this->DiagnoseCycle();
+  // Depth-first search with an explicit stack of the nodes being
+  // visited and the next neighbor of each to follow.
+  std::vector<std::pair<unsigned int, size_t>> stack;
+  auto enter = [this, &stack](unsigned int k) {
+    // Skip nodes already visited.
+    if (this->DirectoryVisited[k]) {
+      if (this->DirectoryVisited[k] == this->WalkId) {
+        // We have reached a node previously visited on this DFS.
+        // There is a cycle.
+        this->DiagnoseCycle();
+      }
+      return;
     }
-    return;
-  }
 
-  // We are now visiting this node so mark it.
-  this->DirectoryVisited[i] = this->WalkId;
+    // We are now visiting this node so mark it.
+    this->DirectoryVisited[k] = this->WalkId;
+    stack.emplace_back(k, 0);
+  };
 
-  // Visit the neighbors of the node first.
-  ConflictList const& clist = this->ConflictGraph[i];
-  for (ConflictPair const& j : clist) {
-    this->VisitDirectory(j.first);
-  }
+  enter(i);
+  while (!stack.empty()) {
+    unsigned int const k = stack.back().first;
+    ConflictList const& clist = this->ConflictGraph[k];
+
+    // Visit the neighbors of the node first.
+    if (stack.back().second < clist.size()) {
+      enter(static_cast<unsigned int>(clist[stack.back().second++].first));
+      continue;
+    }
 
-  // Now that all directories required to come before this one have
-  // been emitted, emit this directory.
-  this->OrderedDirectories.push_back(this->OriginalDirectories[i]);
+    // Now that all directories required to come before this one have
+    // been emitted, emit this directory.
+    this->OrderedDirectories.push_back(this->OriginalDirectories[k]);
+    stack.pop_back();
+  }
 }
 
 void cmOrderDirectories::DiagnoseCycle()
@@ -554,12 +578,6 @@ bool cmOrderDirectories::IsSameDirectory(std::string const& l,
 
 std::string const& cmOrderDirectories::GetRealPath(std::string const& dir)
 {
-  auto i = this->RealPaths.lower_bound(dir);
-  if (i == this->RealPaths.end() ||
-      this->RealPaths.key_comp()(dir, i->first)) {
-    using value_type = std::map<std::string, std::string>::value_type;
-    i = this->RealPaths.insert(
-      i, value_type(dir, cmSystemTools::GetRealPath(dir)));
-  }
-  return i->second;
+  // Share resolved paths with all other targets.
+  return this->GlobalGenerator->GetRealPath(dir);
 }
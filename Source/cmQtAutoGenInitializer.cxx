@@ -529,6 +529,10 @@ bool cmQtAutoGenInitializer::InitCustomTargets()
       }
     }
 
+    // Autogen target job server integration
+    this->AutogenTarget.UseJobServer =
+      this->GenTarget->GetPropertyAsBool("AUTOGEN_USE_JOBSERVER");
+
 #ifdef _WIN32
     {
       auto const& value =
@@ -1486,6 +1490,7 @@ bool cmQtAutoGenInitializer::InitAutogenTarget()
     cc.SetStdPipesUTF8(stdPipesUTF8);
     cc.SetEscapeOldStyle(false);
     cc.SetEscapeAllowMakeVars(true);
+    cc.SetJobserverAware(this->AutogenTarget.UseJobServer);
     this->GenTarget->Target->AddPreBuildCommand(std::move(cc));
   } else {
 
@@ -1616,6 +1621,7 @@ bool cmQtAutoGenInitializer::InitAutogenTarget()
       cc->SetEscapeOldStyle(false);
       cc->SetDepfile(depFile);
       cc->SetStdPipesUTF8(stdPipesUTF8);
+      cc->SetJobserverAware(this->AutogenTarget.UseJobServer);
       this->LocalGen->AddCustomCommandToOutput(std::move(cc));
       dependencies.clear();
       dependencies.emplace_back(std::move(outputFile));
@@ -1631,6 +1637,7 @@ bool cmQtAutoGenInitializer::InitAutogenTarget()
     cc->SetCommandLines(commandLines);
     cc->SetEscapeOldStyle(false);
     cc->SetComment(autogenComment.c_str());
+    cc->SetJobserverAware(this->AutogenTarget.UseJobServer);
     cmTarget* autogenTarget = this->LocalGen->AddUtilityCommand(
       this->AutogenTarget.Name, true, std::move(cc));
     // Create autogen generator target
@@ -1895,6 +1902,7 @@ bool cmQtAutoGenInitializer::SetupWriteAutogenInfo()
   info.SetBool("CROSS_CONFIG", this->CrossConfig);
   info.SetBool("USE_BETTER_GRAPH", this->UseBetterGraph);
   info.SetUInt("PARALLEL", this->AutogenTarget.Parallel);
+  info.SetBool("USE_JOBSERVER", this->AutogenTarget.UseJobServer);
 #ifdef _WIN32
   info.SetUInt("AUTOGEN_COMMAND_LINE_LENGTH_MAX",
                this->AutogenTarget.MaxCommandLineLength);
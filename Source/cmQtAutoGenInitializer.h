@@ -186,6 +186,7 @@ private:
     bool GlobalTarget = false;
     // Settings
     unsigned int Parallel = 1;
+    bool UseJobServer = false;
     unsigned int MaxCommandLineLength =
       std::numeric_limits<unsigned int>::max();
     // Configuration files
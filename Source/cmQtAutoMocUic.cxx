@@ -71,13 +71,15 @@ public:
   /** Search key plus regular expression pair.  */
   struct KeyExpT
   {
-    KeyExpT(std::string key, std::string const& exp)
+    KeyExpT(std::string key, std::string exp)
       : Key(std::move(key))
-      , Exp(exp)
+      , Pattern(std::move(exp))
+      , Exp(this->Pattern)
     {
     }
 
     std::string Key;
+    std::string Pattern;
     cmsys::RegularExpression Exp;
   };
 
@@ -92,8 +94,15 @@ public:
     {
       void Clear();
 
+      //! Hash of the file content the parse data was extracted from
+      std::string ContentHash;
+
       struct MocT
       {
+        //! ContentHash of the file when moc last compiled it successfully
+        std::string ContentHash;
+        //! Time of the output file written by that moc run
+        cmFileTime::TimeType OutputTime = 0;
         std::string Macro;
         struct IncludeT
         {
@@ -174,6 +183,7 @@ public:
     bool UseBetterGraph = false;
     IntegerVersion QtVersion = { 4, 0 };
     unsigned int ThreadCount = 0;
+    bool UseJobServer = false;
     unsigned int MaxCommandLineLength =
       std::numeric_limits<unsigned int>::max();
     // - Directories
@@ -588,6 +598,8 @@ private:
   std::string SettingsFile_;
   std::string SettingsStringMoc_;
   std::string SettingsStringUic_;
+  std::string SettingsStringParse_;
+  bool ParseSettingsChanged_ = false;
   // -- Worker thread pool
   std::atomic<bool> JobError_{ false };
   cmWorkerPool WorkerPool_;
@@ -606,6 +618,10 @@ cmQtAutoMocUicT::IncludeKeyT::IncludeKeyT(std::string const& key,
 
 void cmQtAutoMocUicT::ParseCacheT::FileT::Clear()
 {
+  this->ContentHash.clear();
+
+  this->Moc.ContentHash.clear();
+  this->Moc.OutputTime = 0;
   this->Moc.Macro.clear();
   this->Moc.Include.Underscore.clear();
   this->Moc.Include.Dot.clear();
@@ -668,6 +684,20 @@ bool cmQtAutoMocUicT::ParseCacheT::ReadFromFile(std::string const& fileName)
     }
 
     constexpr std::size_t offset = 5;
+    if (cmHasLiteralPrefix(line, " chs:")) {
+      fileHandle->ContentHash = line.substr(offset);
+      continue;
+    }
+    if (cmHasLiteralPrefix(line, " mch:")) {
+      std::string::size_type const sep = line.find(' ', offset);
+      long long outputTime;
+      if (sep != std::string::npos &&
+          cmStrToLongLong(line.substr(sep + 1), &outputTime)) {
+        fileHandle->Moc.ContentHash = line.substr(offset, sep - offset);
+        fileHandle->Moc.OutputTime = outputTime;
+      }
+      continue;
+    }
     if (cmHasLiteralPrefix(line, " mmc:")) {
       fileHandle->Moc.Macro = line.substr(offset);
       continue;
@@ -708,6 +738,13 @@ bool cmQtAutoMocUicT::ParseCacheT::WriteToFile(std::string const& fileName)
   for (auto const& pair : this->Map_) {
     ofs << pair.first << '\n';
     FileT const& file = *pair.second;
+    if (!file.ContentHash.empty()) {
+      ofs << " chs:" << file.ContentHash << '\n';
+    }
+    if (!file.Moc.ContentHash.empty()) {
+      ofs << " mch:" << file.Moc.ContentHash << ' ' << file.Moc.OutputTime
+          << '\n';
+    }
     if (!file.Moc.Macro.empty()) {
       ofs << " mmc:" << file.Moc.Macro << '\n';
     }
@@ -974,18 +1011,13 @@ bool cmQtAutoMocUicT::JobMocPredefsT::Update(std::string* reason) const
 
 bool cmQtAutoMocUicT::JobParseT::ReadFile()
 {
-  // Clear old parse information
-  this->FileHandle->ParseData->Clear();
+  ParseCacheT::FileT& parseData = *this->FileHandle->ParseData;
   std::string const& fileName = this->FileHandle->FileName;
-  // Write info
-  if (this->Log().Verbose()) {
-    this->Log().Info(GenT::GEN,
-                     cmStrCat("Parsing ", this->MessagePath(fileName)));
-  }
   // Read file content
   {
     std::string error;
     if (!cmQtAutoGenerator::FileRead(this->Content, fileName, &error)) {
+      parseData.Clear();
       this->LogError(GenT::GEN,
                      cmStrCat("Could not read ", this->MessagePath(fileName),
                               ".\n", error));
@@ -994,10 +1026,32 @@ bool cmQtAutoMocUicT::JobParseT::ReadFile()
   }
   // Warn if empty
   if (this->Content.empty()) {
+    parseData.Clear();
     this->Log().Warning(GenT::GEN,
                         cmStrCat(this->MessagePath(fileName), " is empty."));
     return false;
   }
+  // Keep the cached parse information if the content did not change,
+  // e.g. if the file was only touched.
+  cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+  std::string contentHash = hasher.HashString(this->Content);
+  if (contentHash == parseData.ContentHash) {
+    if (this->Log().Verbose()) {
+      this->Log().Info(GenT::GEN,
+                       cmStrCat("Skipping parse of ",
+                                this->MessagePath(fileName),
+                                ", because its content is unchanged."));
+    }
+    return false;
+  }
+  // Clear old parse information
+  parseData.Clear();
+  parseData.ContentHash = std::move(contentHash);
+  // Write info
+  if (this->Log().Verbose()) {
+    this->Log().Info(GenT::GEN,
+                     cmStrCat("Parsing ", this->MessagePath(fileName)));
+  }
   return true;
 }
 
@@ -1817,14 +1871,24 @@ bool cmQtAutoMocUicT::JobProbeDepsMocT::Probe(MappingT const& mapping,
     return true;
   }
 
-  // Test if the source file is newer
+  // Test if the source file is newer.  Its timestamp alone is not enough
+  // if its content is known to be the same as when moc last compiled it,
+  // e.g. after a touch or a branch switch.  Skipping the moc process in
+  // that case keeps the output and everything that includes it intact.
+  // The output must still be the one written by that moc run, and not
+  // one from a later run whose parse cache was never written.
   if (outputFileTime.Older(mapping.SourceFile->FileTime)) {
-    if (reason) {
-      *reason = cmStrCat("Generating ", this->MessagePath(outputFile),
-                         ", because it's older than its source file, from ",
-                         this->MessagePath(sourceFile));
+    ParseCacheT::FileT const& parseData = *mapping.SourceFile->ParseData;
+    if (parseData.ContentHash.empty() ||
+        parseData.ContentHash != parseData.Moc.ContentHash ||
+        outputFileTime.GetTime() != parseData.Moc.OutputTime) {
+      if (reason) {
+        *reason = cmStrCat("Generating ", this->MessagePath(outputFile),
+                           ", because it's older than its source file, from ",
+                           this->MessagePath(sourceFile));
+      }
+      return true;
     }
-    return true;
   }
 
   // Test if the moc_predefs file is newer
@@ -2116,6 +2180,21 @@ void cmQtAutoMocUicT::JobCompileMocT::Process()
     this->Log().Info(GenT::MOC, result.StdOut);
   }
 
+  // Remember which content the output was generated from, now that it
+  // is written
+  {
+    ParseCacheT::FileT& parseData = *this->Mapping->SourceFile->ParseData;
+    cmFileTime outputFileTime;
+    if (!outputFileTime.Load(outputFile)) {
+      parseData.Moc.ContentHash.clear();
+      parseData.Moc.OutputTime = 0;
+    } else {
+      parseData.Moc.ContentHash = parseData.ContentHash;
+      parseData.Moc.OutputTime = outputFileTime.GetTime();
+    }
+    this->BaseEval().ParseCacheChanged = true;
+  }
+
   // Extract dependencies from the dep file moc generated for us
   if (this->MocConst().CanOutputDependencies) {
     std::string const depfile = outputFile + ".d";
@@ -2389,6 +2468,7 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
       !info.GetUInt("QT_VERSION_MINOR", this->BaseConst_.QtVersion.Minor,
                     true) ||
       !info.GetUInt("PARALLEL", this->BaseConst_.ThreadCount, false) ||
+      !info.GetBool("USE_JOBSERVER", this->BaseConst_.UseJobServer, false) ||
 #ifdef _WIN32
       !info.GetUInt("AUTOGEN_COMMAND_LINE_LENGTH_MAX",
                     this->BaseConst_.MaxCommandLineLength, false) ||
@@ -2457,6 +2537,7 @@ bool cmQtAutoMocUicT::InitFromInfo(InfoT const& info)
   this->BaseConst_.ThreadCount =
     std::min(this->BaseConst_.ThreadCount, ParallelMax);
   this->WorkerPool_.SetThreadCount(this->BaseConst_.ThreadCount);
+  this->WorkerPool_.SetUseJobServer(this->BaseConst_.UseJobServer);
 
   // -- Moc
   if (!this->MocConst_.Executable.empty()) {
@@ -2924,6 +3005,37 @@ void cmQtAutoMocUicT::SettingsFileRead()
       }
       this->SettingsStringUic_ = cryptoHash.FinalizeHex();
     }
+
+    // Only these settings affect the results stored in the parse cache
+    cryptoHash.Initialize();
+    cha(this->MocConst().Enabled ? "moc" : "");
+    cha(this->UicConst().Enabled ? "uic" : "");
+    // Skipped files are parsed only for the generators that don't skip
+    // them, so a file that changes its SKIP_AUTOMOC or SKIP_AUTOUIC
+    // property must be parsed again.
+    auto chaSkipList = [&cha](std::unordered_set<std::string> const& list) {
+      std::vector<std::string> sorted(list.begin(), list.end());
+      std::sort(sorted.begin(), sorted.end());
+      std::for_each(sorted.begin(), sorted.end(), cha);
+    };
+    if (this->MocConst().Enabled) {
+      cha(this->MocConst().CanOutputDependencies ? "mocdeps" : "");
+      for (auto const& filter : this->MocConst().DependFilters) {
+        cha(filter.Key);
+        cha(filter.Pattern);
+      }
+      for (auto const& filter : this->MocConst().MacroFilters) {
+        cha(filter.Key);
+        cha(filter.Pattern);
+      }
+      cha("mocskip");
+      chaSkipList(this->MocConst().SkipList);
+    }
+    if (this->UicConst().Enabled) {
+      cha("uicskip");
+      chaSkipList(this->UicConst().SkipList);
+    }
+    this->SettingsStringParse_ = cryptoHash.FinalizeHex();
   }
 
   // Read old settings and compare
@@ -2940,6 +3052,9 @@ void cmQtAutoMocUicT::SettingsFileRead()
           this->UicConst_.SettingsChanged = true;
         }
       }
+      if (this->SettingsStringParse_ != SettingsFind(content, "parse")) {
+        this->ParseSettingsChanged_ = true;
+      }
       // In case any setting changed remove the old settings file.
       // This triggers a full rebuild on the next run if the current
       // build is aborted before writing the current settings in the end.
@@ -2955,6 +3070,7 @@ void cmQtAutoMocUicT::SettingsFileRead()
       if (this->UicConst().Enabled) {
         this->UicConst_.SettingsChanged = true;
       }
+      this->ParseSettingsChanged_ = true;
     }
   }
 }
@@ -2962,7 +3078,8 @@ void cmQtAutoMocUicT::SettingsFileRead()
 bool cmQtAutoMocUicT::SettingsFileWrite()
 {
   // Only write if any setting changed
-  if (this->MocConst().SettingsChanged || this->UicConst().SettingsChanged) {
+  if (this->MocConst().SettingsChanged || this->UicConst().SettingsChanged ||
+      this->ParseSettingsChanged_) {
     if (this->Log().Verbose()) {
       this->Log().Info(GenT::GEN,
                        cmStrCat("Writing the settings file ",
@@ -2979,6 +3096,7 @@ bool cmQtAutoMocUicT::SettingsFileWrite()
       };
       SettingAppend("moc", this->SettingsStringMoc_);
       SettingAppend("uic", this->SettingsStringUic_);
+      SettingAppend("parse", this->SettingsStringParse_);
     }
     // Write settings file
     std::string error;
@@ -3002,8 +3120,7 @@ void cmQtAutoMocUicT::ParseCacheRead()
   if (!this->BaseEval().ParseCacheTime.Load(
         this->BaseConst().ParseCacheFile)) {
     reason = "Refreshing parse cache because it doesn't exist.";
-  } else if (this->MocConst().SettingsChanged ||
-             this->UicConst().SettingsChanged) {
+  } else if (this->ParseSettingsChanged_) {
     reason = "Refreshing parse cache because the settings changed.";
   } else if (this->BaseEval().ParseCacheTime.Older(
                this->BaseConst().CMakeExecutableTime)) {
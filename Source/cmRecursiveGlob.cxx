@@ -0,0 +1,354 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmRecursiveGlob.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#if !defined(_WIN32)
+#  include <dirent.h>
+
+#  include <sys/stat.h>
+#endif
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include <condition_variable>
+#  include <functional>
+#  include <mutex>
+#  include <thread>
+#endif
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+// Directories listed by the calling thread before more threads are
+// started, so that small trees do not pay for them.
+std::size_t const cmRecursiveGlobSerialDirectories = 64;
+
+#if !defined(_WIN32)
+enum class EntryType
+{
+  Directory,
+  Symlink,
+  Other
+};
+
+EntryType GetEntryType(dirent const* entry, std::string const& path)
+{
+#  ifdef DT_UNKNOWN
+  switch (entry->d_type) {
+    case DT_DIR:
+      return EntryType::Directory;
+    case DT_LNK:
+      return EntryType::Symlink;
+    case DT_UNKNOWN:
+      break;
+    default:
+      return EntryType::Other;
+  }
+#  else
+  static_cast<void>(entry);
+#  endif
+  struct stat st;
+  if (lstat(path.c_str(), &st) != 0) {
+    return EntryType::Other;
+  }
+  if (S_ISDIR(st.st_mode)) {
+    return EntryType::Directory;
+  }
+  if (S_ISLNK(st.st_mode)) {
+    return EntryType::Symlink;
+  }
+  return EntryType::Other;
+}
+
+bool IsDotOrDotDot(char const* name)
+{
+  return name[0] == '.' &&
+    (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+std::string JoinPath(std::string const& dir, char const* name)
+{
+  if (!dir.empty() && dir.back() == '/') {
+    return cmStrCat(dir, name);
+  }
+  return cmStrCat(dir, '/', name);
+}
+
+// File names are matched in lower case where cmsys::Glob does.
+std::string MatchName(char const* name)
+{
+#  if defined(__APPLE__)
+  return cmSystemTools::LowerCase(name);
+#  else
+  return name;
+#  endif
+}
+#endif
+}
+
+cmRecursiveGlob::cmRecursiveGlob()
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  this->Jobs = std::max(std::thread::hardware_concurrency(), 1u);
+#endif
+}
+
+void cmRecursiveGlob::SetRelative(std::string relative)
+{
+  this->Relative = std::move(relative);
+}
+
+bool cmRecursiveGlob::FindFiles(std::string const& expr,
+                                cmsys::Glob::GlobMessages* messages)
+{
+  this->Files.clear();
+  this->Directories.clear();
+  this->Expressions.clear();
+#if defined(_WIN32) || defined(__CYGWIN__)
+  // Drive letters, network paths and case-insensitive matching are left
+  // to cmsys::Glob.
+  static_cast<void>(expr);
+  static_cast<void>(messages);
+  return false;
+#else
+  if (expr.empty() || expr[0] != '/' ||
+      expr.find('\\') != std::string::npos) {
+    return false;
+  }
+
+  // The directories before the first wildcard are not matched, as in
+  // cmsys::Glob::FindFiles.
+  std::string::size_type const skip =
+    expr.rfind('/', expr.find_first_of("[?*"));
+  std::vector<std::string> components;
+  for (std::string::size_type pos = skip + 1; pos <= expr.size();) {
+    std::string::size_type end = expr.find('/', pos);
+    if (end == std::string::npos) {
+      end = expr.size();
+    }
+    if (end > pos) {
+      components.push_back(expr.substr(pos, end - pos));
+    }
+    pos = end + 1;
+  }
+  if (components.empty()) {
+    return false;
+  }
+  for (std::string const& component : components) {
+    this->Expressions.emplace_back();
+    if (!this->Expressions.back().compile(
+          cmsys::Glob::PatternToRegex(component))) {
+      return false;
+    }
+  }
+
+  std::vector<std::string> roots;
+  Results results;
+  this->ProcessDirectory(0, cmStrCat(expr.substr(0, skip), '/'), roots,
+                         results);
+  this->Walk(std::move(roots), results);
+  this->Files = std::move(results.Files);
+  // A directory that could not be listed may become readable without
+  // any modification time changing.
+  if (results.Complete) {
+    this->Directories = std::move(results.Directories);
+  }
+  if (messages) {
+    // Keep the messages independent of how the work was scheduled.
+    std::sort(results.Messages.begin(), results.Messages.end(),
+              [](cmsys::Glob::Message const& l,
+                 cmsys::Glob::Message const& r) {
+                return l.content < r.content;
+              });
+    std::move(results.Messages.begin(), results.Messages.end(),
+              std::back_inserter(*messages));
+  }
+  return true;
+#endif
+}
+
+void cmRecursiveGlob::ProcessDirectory(std::size_t start,
+                                       std::string const& dir,
+                                       std::vector<std::string>& roots,
+                                       Results& results) const
+{
+#if !defined(_WIN32)
+  // The last component is matched against the file names of the whole
+  // tree below each directory matched by the other components.
+  if (start + 1 == this->Expressions.size()) {
+    if (cmSystemTools::FileIsDirectory(dir)) {
+      roots.push_back(dir);
+    }
+    return;
+  }
+
+  cmFileTime time;
+  time.Load(dir);
+  DIR* d = opendir(dir.c_str());
+  if (!d) {
+    results.Complete = false;
+    return;
+  }
+  std::vector<std::string> matches;
+  cmsys::RegularExpressionMatch match;
+  while (dirent* entry = readdir(d)) {
+    if (IsDotOrDotDot(entry->d_name)) {
+      continue;
+    }
+    std::string path = JoinPath(dir, entry->d_name);
+    // Symlinks to directories are followed here, as in cmsys::Glob.
+    EntryType const type = GetEntryType(entry, path);
+    if (type == EntryType::Other ||
+        (type == EntryType::Symlink &&
+         !cmSystemTools::FileIsDirectory(path))) {
+      continue;
+    }
+    if (this->Expressions[start].find(MatchName(entry->d_name).c_str(),
+                                      match)) {
+      matches.push_back(std::move(path));
+    }
+  }
+  closedir(d);
+  results.Directories.push_back({ dir, time, cmFileTime::Now() });
+
+  for (std::string const& path : matches) {
+    this->ProcessDirectory(start + 1, path, roots, results);
+  }
+#else
+  static_cast<void>(start);
+  static_cast<void>(dir);
+  static_cast<void>(roots);
+  static_cast<void>(results);
+#endif
+}
+
+void cmRecursiveGlob::Walk(std::vector<std::string> roots,
+                           Results& results) const
+{
+  // Directories still to be listed, used as a stack.
+  std::vector<std::string> pending(std::make_move_iterator(roots.rbegin()),
+                                   std::make_move_iterator(roots.rend()));
+#if !defined(CMAKE_BOOTSTRAP)
+  unsigned int const jobs = std::max(this->Jobs, 1u);
+#else
+  unsigned int const jobs = 1;
+#endif
+  std::size_t listed = 0;
+  while (!pending.empty() &&
+         (jobs == 1 || listed < cmRecursiveGlobSerialDirectories)) {
+    std::string const dir = std::move(pending.back());
+    pending.pop_back();
+    this->ListDirectory(dir, results, pending);
+    ++listed;
+  }
+  if (pending.empty()) {
+    return;
+  }
+
+#if !defined(CMAKE_BOOTSTRAP)
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::size_t busy = 0;
+  std::vector<Results> jobResults(jobs);
+  auto work = [&](Results& local) {
+    std::vector<std::string> found;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+      // Other threads may still add directories while any is busy.
+      changed.wait(lock, [&]() { return !pending.empty() || busy == 0; });
+      if (pending.empty()) {
+        return;
+      }
+      std::string const dir = std::move(pending.back());
+      pending.pop_back();
+      ++busy;
+      lock.unlock();
+      this->ListDirectory(dir, local, found);
+      lock.lock();
+      --busy;
+      std::move(found.begin(), found.end(), std::back_inserter(pending));
+      found.clear();
+      changed.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(jobs - 1);
+  for (unsigned int j = 1; j < jobs; ++j) {
+    workers.emplace_back(work, std::ref(jobResults[j]));
+  }
+  work(jobResults[0]);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (Results& local : jobResults) {
+    std::move(local.Files.begin(), local.Files.end(),
+              std::back_inserter(results.Files));
+    std::move(local.Messages.begin(), local.Messages.end(),
+              std::back_inserter(results.Messages));
+    std::move(local.Directories.begin(), local.Directories.end(),
+              std::back_inserter(results.Directories));
+    results.Complete = results.Complete && local.Complete;
+  }
+#endif
+}
+
+void cmRecursiveGlob::ListDirectory(std::string const& dir, Results& results,
+                                    std::vector<std::string>& subdirs) const
+{
+#if !defined(_WIN32)
+  // The time is loaded first so that changes made while listing are
+  // noticed later.
+  cmFileTime time;
+  time.Load(dir);
+  DIR* d = opendir(dir.c_str());
+  if (!d) {
+    results.Complete = false;
+    results.Messages.emplace_back(
+      cmsys::Glob::warning,
+      cmStrCat("Error listing directory '", dir, "'! Reason: '",
+               std::strerror(errno), '\''));
+    return;
+  }
+  cmsys::RegularExpressionMatch match;
+  while (dirent* entry = readdir(d)) {
+    if (IsDotOrDotDot(entry->d_name)) {
+      continue;
+    }
+    std::string path = JoinPath(dir, entry->d_name);
+    // Symlinks are matched like files since they are not followed.
+    if (GetEntryType(entry, path) == EntryType::Directory) {
+      if (this->ListDirectories) {
+        this->AddFile(path, results);
+      }
+      subdirs.push_back(std::move(path));
+    } else if (this->Expressions.back().find(
+                 MatchName(entry->d_name).c_str(), match)) {
+      this->AddFile(path, results);
+    }
+  }
+  closedir(d);
+  results.Directories.push_back({ dir, time, cmFileTime::Now() });
+#else
+  static_cast<void>(dir);
+  static_cast<void>(results);
+  static_cast<void>(subdirs);
+#endif
+}
+
+void cmRecursiveGlob::AddFile(std::string const& path, Results& results) const
+{
+  if (this->Relative.empty()) {
+    results.Files.push_back(path);
+  } else {
+    results.Files.push_back(
+      cmSystemTools::RelativePath(this->Relative, path));
+  }
+}
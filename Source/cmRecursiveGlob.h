@@ -0,0 +1,82 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "cmsys/Glob.hxx"
+#include "cmsys/RegularExpression.hxx"
+
+#include "cmGlobCacheEntry.h"
+
+/** \class cmRecursiveGlob
+ * \brief Finds the files matched by a file(GLOB_RECURSE) expression.
+ *
+ * This finds the same files as cmsys::Glob in recursive mode when
+ * symlinks to directories are not followed.  The type of each entry is
+ * taken from the directory listing where the platform reports it, so
+ * most entries are never passed to stat().  Large trees are listed by
+ * several threads.
+ */
+class cmRecursiveGlob
+{
+public:
+  cmRecursiveGlob();
+
+  /** Also report the directories found while recursing.  */
+  void SetListDirectories(bool listDirs) { this->ListDirectories = listDirs; }
+
+  /** Report paths relative to the given directory.  */
+  void SetRelative(std::string relative);
+
+  /** Number of threads used to list directories.  */
+  void SetJobs(unsigned int jobs) { this->Jobs = jobs; }
+
+  /**
+   * Finds the files matched by the absolute expression.  Returns false
+   * without searching if the expression needs cmsys::Glob, for example
+   * because it contains escapes or this platform is not supported.
+   */
+  bool FindFiles(std::string const& expr,
+                 cmsys::Glob::GlobMessages* messages = nullptr);
+
+  std::vector<std::string>& GetFiles() { return this->Files; }
+
+  /**
+   * The directories listed by the last search, with their modification
+   * times from before they were listed and the times the listings ended.
+   * Empty if a directory could not be listed.
+   */
+  std::vector<cmGlobDirectory>& GetDirectories()
+  {
+    return this->Directories;
+  }
+
+private:
+  struct Results
+  {
+    std::vector<std::string> Files;
+    cmsys::Glob::GlobMessages Messages;
+    std::vector<cmGlobDirectory> Directories;
+    bool Complete = true;
+  };
+
+  void ProcessDirectory(std::size_t start, std::string const& dir,
+                        std::vector<std::string>& roots,
+                        Results& results) const;
+  void Walk(std::vector<std::string> roots, Results& results) const;
+  void ListDirectory(std::string const& dir, Results& results,
+                     std::vector<std::string>& subdirs) const;
+  void AddFile(std::string const& path, Results& results) const;
+
+  bool ListDirectories = false;
+  std::string Relative;
+  unsigned int Jobs = 1;
+  std::vector<cmsys::RegularExpression> Expressions;
+  std::vector<std::string> Files;
+  std::vector<cmGlobDirectory> Directories;
+};
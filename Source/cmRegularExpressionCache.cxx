@@ -0,0 +1,87 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmRegularExpressionCache.h"
+
+#include "cmMakefile.h"
+#include "cmMessageType.h"
+#include "cmStringAlgorithms.h"
+#include "cmValue.h"
+
+template <typename Regex>
+Regex* cmRegularExpressionCache::Entries<Regex>::Get(
+  std::string const& pattern, Statistics& stats)
+{
+  auto it = this->Index.find(pattern);
+  if (it != this->Index.end()) {
+    ++stats.Hits;
+    this->List.splice(this->List.begin(), this->List, it->second);
+    return &it->second->second;
+  }
+
+  // Patterns that do not compile are not kept so that every use
+  // reports the error.
+  ++stats.Misses;
+  this->List.emplace_front(pattern, Regex());
+  if (!this->List.front().second.compile(pattern)) {
+    this->List.pop_front();
+    return nullptr;
+  }
+  this->Index.emplace(pattern, this->List.begin());
+
+  if (this->List.size() > Capacity) {
+    this->Index.erase(this->List.back().first);
+    this->List.pop_back();
+    ++stats.Evictions;
+  }
+  return &this->List.front().second;
+}
+
+cmRegularExpressionCache& cmRegularExpressionCache::Instance()
+{
+  static thread_local cmRegularExpressionCache cache;
+  return cache;
+}
+
+cmsys::RegularExpression* cmRegularExpressionCache::Get(
+  std::string const& pattern)
+{
+  cmRegularExpressionCache& cache = Instance();
+  return cache.Backtracking.Get(pattern, cache.Stats);
+}
+
+cmLinearRegularExpression* cmRegularExpressionCache::GetLinear(
+  std::string const& pattern)
+{
+  cmRegularExpressionCache& cache = Instance();
+  return cache.Linear.Get(pattern, cache.Stats);
+}
+
+bool cmRegularExpressionCache::UseLinearEngine(cmMakefile const& mf)
+{
+  cmValue const engine = mf.GetDefinition("CMAKE_REGEX_ENGINE");
+  if (!engine || engine->empty() || *engine == "BACKTRACKING") {
+    return false;
+  }
+  if (*engine == "LINEAR") {
+    return true;
+  }
+  mf.IssueMessage(MessageType::FATAL_ERROR,
+                  cmStrCat("CMAKE_REGEX_ENGINE is set to \"", *engine,
+                           "\", which is not BACKTRACKING or LINEAR."));
+  return false;
+}
+
+cmRegularExpressionCache::Statistics cmRegularExpressionCache::GetStatistics()
+{
+  cmRegularExpressionCache const& cache = Instance();
+  Statistics stats = cache.Stats;
+  stats.Size = cache.Backtracking.Size() + cache.Linear.Size();
+  return stats;
+}
+
+void cmRegularExpressionCache::Clear()
+{
+  cmRegularExpressionCache& cache = Instance();
+  cache.Backtracking.Clear();
+  cache.Linear.Clear();
+}
@@ -0,0 +1,90 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "cmsys/RegularExpression.hxx"
+
+#include "cmLinearRegularExpression.h"
+
+class cmMakefile;
+
+/** \class cmRegularExpressionCache
+ * \brief Keeps the most recently used compiled regular expressions.
+ *
+ * Commands that match the same pattern many times, such as
+ * string(REGEX) or if(MATCHES) in a loop, look the pattern up here
+ * instead of compiling it again.  Each thread has its own cache.
+ */
+class cmRegularExpressionCache
+{
+public:
+  /** Number of compiled expressions kept by each cache per engine.  */
+  static std::size_t const Capacity = 128;
+
+  struct Statistics
+  {
+    std::size_t Hits = 0;
+    std::size_t Misses = 0;
+    std::size_t Evictions = 0;
+    std::size_t Size = 0;
+  };
+
+  /**
+   * @brief Returns the compiled form of a pattern.
+   * @return nullptr if the pattern does not compile.
+   *
+   * The expression belongs to the calling thread's cache.  It, and the
+   * match state left by the last find(), stay valid until the next call
+   * to Get() or Clear() on the same thread.
+   */
+  static cmsys::RegularExpression* Get(std::string const& pattern);
+
+  /** Same as Get() for the linear time engine.  */
+  static cmLinearRegularExpression* GetLinear(std::string const& pattern);
+
+  /** Returns true if CMAKE_REGEX_ENGINE selects the linear time engine.
+   *  Reports an error for a value that names no engine.  */
+  static bool UseLinearEngine(cmMakefile const& mf);
+
+  /** Returns the counters of the calling thread's cache.  */
+  static Statistics GetStatistics();
+
+  /** Drops all compiled expressions of the calling thread's cache.  */
+  static void Clear();
+
+private:
+  template <typename Regex>
+  class Entries
+  {
+  public:
+    Regex* Get(std::string const& pattern, Statistics& stats);
+    std::size_t Size() const { return this->List.size(); }
+    void Clear()
+    {
+      this->Index.clear();
+      this->List.clear();
+    }
+
+  private:
+    using Entry = std::pair<std::string, Regex>;
+
+    // Most recently used entries come first.
+    std::list<Entry> List;
+    std::unordered_map<std::string, typename std::list<Entry>::iterator>
+      Index;
+  };
+
+  static cmRegularExpressionCache& Instance();
+
+  Entries<cmsys::RegularExpression> Backtracking;
+  Entries<cmLinearRegularExpression> Linear;
+  Statistics Stats;
+};
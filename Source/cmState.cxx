@@ -6,6 +6,7 @@
 #include <array>
 #include <cassert>
 #include <cstdlib>
+#include <memory>
 #include <utility>
 
 #include <cm/memory>
@@ -226,6 +227,11 @@ std::string const& cmState::GetGlobVerifyScript() const
   return this->GlobVerificationManager->GetVerifyScript();
 }
 
+std::string const& cmState::GetGlobVerifyData() const
+{
+  return this->GlobVerificationManager->GetVerifyData();
+}
+
 std::string const& cmState::GetGlobVerifyStamp() const
 {
   return this->GlobVerificationManager->GetVerifyStamp();
@@ -524,7 +530,14 @@ bool cmState::AddScriptedCommand(std::string const& name, BT<Command> command,
     this->ScriptedCommands["_" + sName] = oldCmd;
   }
 
-  this->ScriptedCommands[sName] = std::move(command.Value);
+  // Looking up a command copies it.  Share the definition, which holds
+  // the whole body of a function or macro, so that the copy is cheap.
+  auto shared = std::make_shared<Command const>(std::move(command.Value));
+  this->ScriptedCommands[sName] =
+    [shared](std::vector<cmListFileArgument> const& args,
+             cmExecutionStatus& status) -> bool {
+    return (*shared)(args, status);
+  };
   return true;
 }
 
@@ -262,6 +262,7 @@ private:
 
   bool DoWriteGlobVerifyTarget() const;
   std::string const& GetGlobVerifyScript() const;
+  std::string const& GetGlobVerifyData() const;
   std::string const& GetGlobVerifyStamp() const;
   bool SaveVerificationScript(std::string const& path, cmMessenger* messenger);
   void AddGlobCacheEntry(cmGlobCacheEntry const& entry,
@@ -225,6 +225,27 @@ void cmStateSnapshot::RemoveDefinition(std::string const& name)
   this->Position->Vars->Unset(name);
 }
 
+bool cmStateSnapshot::AppendDefinition(std::string const& name,
+                                       cm::string_view elements)
+{
+  return cmDefinitions::Append(name, elements, this->Position->Vars,
+                               this->Position->Root);
+}
+
+bool cmStateSnapshot::PrependDefinition(std::string const& name,
+                                        cm::string_view elements)
+{
+  return cmDefinitions::Prepend(name, elements, this->Position->Vars,
+                                this->Position->Root);
+}
+
+cmListDefinition const* cmStateSnapshot::GetListDefinition(
+  std::string const& name) const
+{
+  return cmDefinitions::GetList(name, this->Position->Vars,
+                                this->Position->Root);
+}
+
 std::vector<std::string> cmStateSnapshot::ClosureKeys() const
 {
   return cmDefinitions::ClosureKeys(this->Position->Vars,
@@ -14,6 +14,7 @@
 #include "cmStateTypes.h"
 #include "cmValue.h"
 
+class cmListDefinition;
 class cmPackageState;
 class cmState;
 class cmStateDirectory;
@@ -28,6 +29,9 @@ public:
   bool IsInitialized(std::string const& name) const;
   void SetDefinition(std::string const& name, cm::string_view value);
   void RemoveDefinition(std::string const& name);
+  bool AppendDefinition(std::string const& name, cm::string_view elements);
+  bool PrependDefinition(std::string const& name, cm::string_view elements);
+  cmListDefinition const* GetListDefinition(std::string const& name) const;
   std::vector<std::string> ClosureKeys() const;
   bool RaiseScope(std::string const& var, char const* varDef);
 
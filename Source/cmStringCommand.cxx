@@ -31,6 +31,7 @@
 #include "cmMessageType.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
+#include "cmRegularExpressionCache.h"
 #include "cmStringAlgorithms.h"
 #include "cmStringReplaceHelper.h"
 #include "cmSubcommandTable.h"
@@ -224,8 +225,9 @@ bool HandleRegexCommand(std::vector<std::string> const& args,
   return false;
 }
 
-bool RegexMatch(std::vector<std::string> const& args,
-                cmExecutionStatus& status)
+template <typename Regex>
+bool RegexMatchUsing(Regex* re, std::vector<std::string> const& args,
+                     cmExecutionStatus& status)
 {
   //"STRING(REGEX MATCH <regular_expression> <output variable>
   // <input> [<input>...])\n";
@@ -233,9 +235,7 @@ bool RegexMatch(std::vector<std::string> const& args,
   std::string const& outvar = args[3];
 
   status.GetMakefile().ClearMatches();
-  // Compile the regular expression.
-  cmsys::RegularExpression re;
-  if (!re.compile(regex)) {
+  if (!re) {
     std::string e =
       "sub-command REGEX, mode MATCH failed to compile regex \"" + regex +
       "\".";
@@ -248,9 +248,9 @@ bool RegexMatch(std::vector<std::string> const& args,
 
   // Scan through the input for all matches.
   std::string output;
-  if (re.find(input)) {
-    status.GetMakefile().StoreMatches(re);
-    output = re.match();
+  if (re->find(input)) {
+    status.GetMakefile().StoreMatches(*re);
+    output = re->match();
   }
 
   // Store the output in the provided variable.
@@ -258,8 +258,21 @@ bool RegexMatch(std::vector<std::string> const& args,
   return true;
 }
 
-bool RegexMatchAll(std::vector<std::string> const& args,
-                   cmExecutionStatus& status)
+bool RegexMatch(std::vector<std::string> const& args,
+                cmExecutionStatus& status)
+{
+  // Look up the compiled regular expression.
+  if (cmRegularExpressionCache::UseLinearEngine(status.GetMakefile())) {
+    return RegexMatchUsing(cmRegularExpressionCache::GetLinear(args[2]), args,
+                           status);
+  }
+  return RegexMatchUsing(cmRegularExpressionCache::Get(args[2]), args,
+                         status);
+}
+
+template <typename Regex>
+bool RegexMatchAllUsing(Regex* re, std::vector<std::string> const& args,
+                        cmExecutionStatus& status)
 {
   //"STRING(REGEX MATCHALL <regular_expression> <output variable> <input>
   // [<input>...])\n";
@@ -267,9 +280,7 @@ bool RegexMatchAll(std::vector<std::string> const& args,
   std::string const& outvar = args[3];
 
   status.GetMakefile().ClearMatches();
-  // Compile the regular expression.
-  cmsys::RegularExpression re;
-  if (!re.compile(regex)) {
+  if (!re) {
     std::string e =
       "sub-command REGEX, mode MATCHALL failed to compile regex \"" + regex +
       "\".";
@@ -290,19 +301,19 @@ bool RegexMatchAll(std::vector<std::string> const& args,
   std::string output;
   std::string::size_type base = 0;
   unsigned optNonEmpty = 0;
-  while (re.find(input, base, optAnchor | optNonEmpty)) {
+  while (re->find(input, base, optAnchor | optNonEmpty)) {
     status.GetMakefile().ClearMatches();
-    status.GetMakefile().StoreMatches(re);
+    status.GetMakefile().StoreMatches(*re);
     if (!output.empty() || optNonEmpty) {
       output += ";";
     }
-    output += re.match();
-    base = re.end();
+    output += re->match();
+    base = re->end();
 
-    if (re.start() == input.length()) {
+    if (re->start() == input.length()) {
       break;
     }
-    if (re.start() == re.end()) {
+    if (re->start() == re->end()) {
       optNonEmpty = cmsys::RegularExpression::NONEMPTY_AT_OFFSET;
     } else {
       optNonEmpty = 0;
@@ -314,6 +325,18 @@ bool RegexMatchAll(std::vector<std::string> const& args,
   return true;
 }
 
+bool RegexMatchAll(std::vector<std::string> const& args,
+                   cmExecutionStatus& status)
+{
+  // Look up the compiled regular expression.
+  if (cmRegularExpressionCache::UseLinearEngine(status.GetMakefile())) {
+    return RegexMatchAllUsing(cmRegularExpressionCache::GetLinear(args[2]),
+                              args, status);
+  }
+  return RegexMatchAllUsing(cmRegularExpressionCache::Get(args[2]), args,
+                            status);
+}
+
 bool RegexReplace(std::vector<std::string> const& args,
                   cmExecutionStatus& status)
 {
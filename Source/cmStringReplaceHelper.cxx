@@ -8,20 +8,41 @@
 
 #include "cmMakefile.h"
 #include "cmPolicies.h"
+#include "cmRegularExpressionCache.h"
 
 cmStringReplaceHelper::cmStringReplaceHelper(std::string const& regex,
                                              std::string replace_expr,
                                              cmMakefile* makefile)
   : RegExString(regex)
-  , RegularExpression(regex)
   , ReplaceExpression(std::move(replace_expr))
   , Makefile(makefile)
 {
+  // Copying a compiled expression is cheaper than compiling it again.
+  if (makefile && cmRegularExpressionCache::UseLinearEngine(*makefile)) {
+    this->UseLinear = true;
+    if (cmLinearRegularExpression const* cached =
+          cmRegularExpressionCache::GetLinear(regex)) {
+      this->LinearExpression = *cached;
+    }
+  } else if (cmsys::RegularExpression const* cached =
+               cmRegularExpressionCache::Get(regex)) {
+    this->RegularExpression = *cached;
+  }
   this->ParseReplaceExpression();
 }
 
 bool cmStringReplaceHelper::Replace(std::string const& input,
                                     std::string& output)
+{
+  if (this->UseLinear) {
+    return this->ReplaceUsing(this->LinearExpression, input, output);
+  }
+  return this->ReplaceUsing(this->RegularExpression, input, output);
+}
+
+template <typename Regex>
+bool cmStringReplaceHelper::ReplaceUsing(Regex& re, std::string const& input,
+                                         std::string& output)
 {
   output.clear();
 
@@ -33,7 +54,6 @@ bool cmStringReplaceHelper::Replace(std::string const& input,
   }
 
   // Scan through the input for all matches.
-  auto& re = this->RegularExpression;
   std::string::size_type base = 0;
   unsigned optNonEmpty = 0;
   while (re.find(input, base, optAnchor | optNonEmpty)) {
@@ -8,6 +8,8 @@
 
 #include "cmsys/RegularExpression.hxx"
 
+#include "cmLinearRegularExpression.h"
+
 class cmMakefile;
 
 class cmStringReplaceHelper
@@ -18,7 +20,8 @@ public:
 
   bool IsRegularExpressionValid() const
   {
-    return this->RegularExpression.is_valid();
+    return this->UseLinear ? this->LinearExpression.is_valid()
+                           : this->RegularExpression.is_valid();
   }
   bool IsReplaceExpressionValid() const
   {
@@ -55,9 +58,14 @@ private:
 
   void ParseReplaceExpression();
 
+  template <typename Regex>
+  bool ReplaceUsing(Regex& re, std::string const& input, std::string& output);
+
   std::string ErrorString;
   std::string RegExString;
   cmsys::RegularExpression RegularExpression;
+  cmLinearRegularExpression LinearExpression;
+  bool UseLinear = false;
   bool ValidReplaceExpression = true;
   std::string ReplaceExpression;
   std::vector<RegexReplacement> Replacements;
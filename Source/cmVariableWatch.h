@@ -34,6 +34,11 @@ public:
   void RemoveWatch(std::string const& variable, WatchMethod method,
                    void* client_data = nullptr);
 
+  /**
+   * Return true if the variable has watches
+   */
+  bool IsWatched(std::string const& variable) const;
+
   /**
    * This method is called when variable is accessed
    */
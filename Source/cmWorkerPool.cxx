@@ -12,6 +12,7 @@
 #include <thread>
 
 #include <cm/memory>
+#include <cm/optional>
 
 #include <cm3p/uv.h>
 
@@ -19,6 +20,7 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmUVHandlePtr.h"
+#include "cmUVJobServerClient.h"
 
 /**
  * @brief libuv pipe buffer class
@@ -383,7 +385,7 @@ void cmUVReadOnlyProcess::UVTryFinish()
 class cmWorkerPoolWorker
 {
 public:
-  cmWorkerPoolWorker(uv_loop_t& uvLoop);
+  cmWorkerPoolWorker(cmWorkerPoolInternal& gint, uv_loop_t& uvLoop);
   ~cmWorkerPoolWorker();
 
   cmWorkerPoolWorker(cmWorkerPoolWorker const&) = delete;
@@ -402,9 +404,14 @@ public:
                   std::string const& workingDirectory);
 
 private:
+  //! Needs access to StartProcess()
+  friend class cmWorkerPoolInternal;
+
   // -- Libuv callbacks
   static void UVProcessStart(uv_async_t* handle);
   void UVProcessFinished();
+  void StartProcess();
+  void ReleaseToken();
 
   // -- Process management
   struct
@@ -413,12 +420,17 @@ private:
     cm::uv_async_ptr Request;
     std::condition_variable Condition;
     std::unique_ptr<cmUVReadOnlyProcess> ROP;
+    // Accessed from the libuv loop thread only
+    bool HoldsToken = false;
   } Proc_;
+  cmWorkerPoolInternal& GInt_;
   // -- System thread
   std::thread Thread_;
 };
 
-cmWorkerPoolWorker::cmWorkerPoolWorker(uv_loop_t& uvLoop)
+cmWorkerPoolWorker::cmWorkerPoolWorker(cmWorkerPoolInternal& gint,
+                                       uv_loop_t& uvLoop)
+  : GInt_(gint)
 {
   this->Proc_.Request.init(uvLoop, &cmWorkerPoolWorker::UVProcessStart, this);
 }
@@ -456,35 +468,6 @@ bool cmWorkerPoolWorker::RunProcess(cmWorkerPool::ProcessResultT& result,
   return !result.error();
 }
 
-void cmWorkerPoolWorker::UVProcessStart(uv_async_t* handle)
-{
-  auto* worker = reinterpret_cast<cmWorkerPoolWorker*>(handle->data);
-  bool startFailed = false;
-  {
-    auto& Proc = worker->Proc_;
-    std::lock_guard<std::mutex> lock(Proc.Mutex);
-    if (Proc.ROP && !Proc.ROP->IsStarted()) {
-      startFailed = !Proc.ROP->start(
-        handle->loop, [worker] { worker->UVProcessFinished(); });
-    }
-  }
-  // Clean up if starting of the process failed
-  if (startFailed) {
-    worker->UVProcessFinished();
-  }
-}
-
-void cmWorkerPoolWorker::UVProcessFinished()
-{
-  std::lock_guard<std::mutex> lock(this->Proc_.Mutex);
-  if (this->Proc_.ROP &&
-      (this->Proc_.ROP->IsFinished() || !this->Proc_.ROP->IsStarted())) {
-    this->Proc_.ROP.reset();
-  }
-  // Notify idling thread
-  this->Proc_.Condition.notify_one();
-}
-
 /**
  * @brief Private worker pool internals
  */
@@ -519,11 +502,19 @@ public:
   static void UVSlotBegin(uv_async_t* handle);
   static void UVSlotEnd(uv_async_t* handle);
 
+  // -- Job server
+  void JobServerReceivedToken();
+
   // -- UV loop
   std::unique_ptr<uv_loop_t> UVLoop;
   cm::uv_async_ptr UVRequestBegin;
   cm::uv_async_ptr UVRequestEnd;
 
+  // -- Job server client and the workers waiting for a token.
+  //    Accessed from the libuv loop thread only.
+  cm::optional<cmUVJobServerClient> JobServer;
+  std::deque<cmWorkerPoolWorker*> JobServerWaiting;
+
   // -- Thread pool and job queue
   std::mutex Mutex;
   bool Processing = false;
@@ -541,6 +532,64 @@ public:
   cmWorkerPool* Pool = nullptr;
 };
 
+void cmWorkerPoolWorker::UVProcessStart(uv_async_t* handle)
+{
+  auto* worker = reinterpret_cast<cmWorkerPoolWorker*>(handle->data);
+  // Wait for a job server token before starting the process
+  if (worker->GInt_.JobServer) {
+    worker->GInt_.JobServerWaiting.push_back(worker);
+    worker->GInt_.JobServer->RequestToken();
+    return;
+  }
+  worker->StartProcess();
+}
+
+void cmWorkerPoolWorker::StartProcess()
+{
+  bool started = false;
+  bool startFailed = false;
+  {
+    auto& Proc = this->Proc_;
+    std::lock_guard<std::mutex> lock(Proc.Mutex);
+    if (Proc.ROP && !Proc.ROP->IsStarted()) {
+      started = Proc.ROP->start(this->GInt_.UVLoop.get(),
+                                [this] { this->UVProcessFinished(); });
+      startFailed = !started;
+    }
+  }
+  // Return the job server token if no process runs on it
+  if (!started) {
+    this->ReleaseToken();
+  }
+  // Clean up if starting of the process failed
+  if (startFailed) {
+    this->UVProcessFinished();
+  }
+}
+
+void cmWorkerPoolWorker::ReleaseToken()
+{
+  if (this->Proc_.HoldsToken) {
+    this->Proc_.HoldsToken = false;
+    if (this->GInt_.JobServer) {
+      this->GInt_.JobServer->ReleaseToken();
+    }
+  }
+}
+
+void cmWorkerPoolWorker::UVProcessFinished()
+{
+  // Return the job server token as soon as the process is done
+  this->ReleaseToken();
+  std::lock_guard<std::mutex> lock(this->Proc_.Mutex);
+  if (this->Proc_.ROP &&
+      (this->Proc_.ROP->IsFinished() || !this->Proc_.ROP->IsStarted())) {
+    this->Proc_.ROP.reset();
+  }
+  // Notify idling thread
+  this->Proc_.Condition.notify_one();
+}
+
 void cmWorkerPool::ProcessResultT::reset()
 {
   this->ExitStatus = 0;
@@ -583,6 +632,12 @@ bool cmWorkerPoolInternal::Process()
                             this);
   this->UVRequestEnd.init(*this->UVLoop, &cmWorkerPoolInternal::UVSlotEnd,
                           this);
+  // Connect to the ambient job server, if requested and available
+  if (this->Pool->UseJobServer()) {
+    this->JobServer = cmUVJobServerClient::Connect(
+      *this->UVLoop, /*onToken=*/[this]() { this->JobServerReceivedToken(); },
+      /*onDisconnect=*/nullptr);
+  }
   // Send begin request
   this->UVRequestBegin.send();
   // Run libuv loop
@@ -631,7 +686,7 @@ void cmWorkerPoolInternal::UVSlotBegin(uv_async_t* handle)
     gint.Workers.reserve(num);
     for (unsigned int ii = 0; ii != num; ++ii) {
       gint.Workers.emplace_back(
-        cm::make_unique<cmWorkerPoolWorker>(*gint.UVLoop));
+        cm::make_unique<cmWorkerPoolWorker>(gint, *gint.UVLoop));
     }
     // Start worker threads
     for (unsigned int ii = 0; ii != num; ++ii) {
@@ -648,10 +703,26 @@ void cmWorkerPoolInternal::UVSlotEnd(uv_async_t* handle)
   auto& gint = *reinterpret_cast<cmWorkerPoolInternal*>(handle->data);
   // Join and destroy worker threads
   gint.Workers.clear();
+  // Disconnect from the job server
+  gint.JobServerWaiting.clear();
+  gint.JobServer.reset();
   // Destroy end request
   gint.UVRequestEnd.reset();
 }
 
+void cmWorkerPoolInternal::JobServerReceivedToken()
+{
+  if (this->JobServerWaiting.empty()) {
+    // Nobody is waiting anymore.
+    this->JobServer->ReleaseToken();
+    return;
+  }
+  cmWorkerPoolWorker* worker = this->JobServerWaiting.front();
+  this->JobServerWaiting.pop_front();
+  worker->Proc_.HoldsToken = true;
+  worker->StartProcess();
+}
+
 void cmWorkerPoolInternal::Work(unsigned int workerIndex)
 {
   cmWorkerPool::JobHandleT jobHandle;
@@ -756,6 +827,13 @@ void cmWorkerPool::SetThreadCount(unsigned int threadCount)
   }
 }
 
+void cmWorkerPool::SetUseJobServer(bool useJobServer)
+{
+  if (!this->Int_->Processing) {
+    this->UseJobServer_ = useJobServer;
+  }
+}
+
 bool cmWorkerPool::Process(void* userData)
 {
   // Setup user data
@@ -168,6 +168,17 @@ public:
    */
   void SetThreadCount(unsigned int threadCount);
 
+  /**
+   * Whether external processes started by jobs acquire a token from an
+   * ambient GNU make job server, if any, before they are started.
+   *
+   * This bounds the number of concurrent processes across all tools that
+   * share the job server.  Calling this method during Process() has no
+   * effect.
+   */
+  void SetUseJobServer(bool useJobServer);
+  bool UseJobServer() const { return this->UseJobServer_; }
+
   /**
    * Blocking function that starts threads to process all Jobs in the queue.
    *
@@ -216,5 +227,6 @@ public:
 private:
   void* UserData_ = nullptr;
   unsigned int ThreadCount_ = 1;
+  bool UseJobServer_ = false;
   std::unique_ptr<cmWorkerPoolInternal> Int_;
 };
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <initializer_list>
@@ -48,7 +49,9 @@
 #include "cmDocumentationEntry.h"
 #include "cmDuration.h"
 #include "cmExternalMakefileProjectGenerator.h"
+#include "cmFileTime.h"
 #include "cmFileTimeCache.h"
+#include "cmGeneratedFileStream.h"
 #include "cmGeneratorTarget.h"
 #include "cmGlobCacheEntry.h"
 #include "cmGlobalGenerator.h"
@@ -77,6 +80,8 @@
 #include "cmWorkingDirectory.h"
 
 #if !defined(CMAKE_BOOTSTRAP)
+#  include <atomic>
+#  include <thread>
 #  include <unordered_map>
 
 #  include <cm3p/curl/curl.h>
@@ -238,6 +243,63 @@ bool cmakeCheckStampFile(std::string const& stampName)
   return false;
 }
 
+// Build system checks stat at least this many files per thread.
+std::size_t const cmakeFileTimesPerJob = 64;
+
+/* Load the modification time of each file into the matching entry of
+   'times'.  Large lists are split across threads.  Loading stops early
+   once a file cannot be loaded.  Returns the lowest index of a file that
+   could not be loaded, or the number of files if all of them were.  */
+std::size_t cmakeLoadFileTimes(std::vector<std::string> const& files,
+                               std::vector<cmFileTime>& times)
+{
+  std::size_t const count = files.size();
+  times.assign(count, cmFileTime());
+  unsigned int jobs = 1;
+#ifndef CMAKE_BOOTSTRAP
+  if (count >= 2 * cmakeFileTimesPerJob) {
+    jobs = static_cast<unsigned int>(std::min<std::size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u),
+      count / cmakeFileTimesPerJob));
+  }
+#endif
+  if (jobs <= 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!times[i].Load(files[i])) {
+        return i;
+      }
+    }
+    return count;
+  }
+
+#ifndef CMAKE_BOOTSTRAP
+  // Indices are claimed in increasing order, so every index below the
+  // first failure is still loaded and the result does not depend on
+  // how the work was scheduled.
+  std::atomic<std::size_t> next(0);
+  std::atomic<std::size_t> failed(count);
+  std::vector<std::thread> workers;
+  workers.reserve(jobs);
+  for (unsigned int j = 0; j < jobs; ++j) {
+    workers.emplace_back([&]() {
+      for (std::size_t i = next++; i < failed; i = next++) {
+        if (!times[i].Load(files[i])) {
+          std::size_t lowest = failed;
+          while (i < lowest && !failed.compare_exchange_weak(lowest, i)) {
+          }
+        }
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return failed;
+#else
+  return count;
+#endif
+}
+
 bool cmakeCheckStampList(std::string const& stampList)
 {
   // If the stamp list does not exist CMake must rerun to generate it.
@@ -961,6 +1023,7 @@ void cmake::SetArgs(std::vector<std::string> const& args)
 #if !defined(CMAKE_BOOTSTRAP)
   std::string profilingFormat;
   std::string profilingOutput;
+  bool profilingMemory = false;
   std::string presetName;
 
   ListPresets listPresets = ListPresets::None;
@@ -1364,6 +1427,12 @@ void cmake::SetArgs(std::vector<std::string> const& args)
                            profilingFormat = value;
                            return true;
                          });
+  arguments.emplace_back("--profiling-memory", CommandArgument::Values::Zero,
+                         [&profilingMemory](std::string const&,
+                                            cmake*) -> bool {
+                           profilingMemory = true;
+                           return true;
+                         });
   arguments.emplace_back(
     "--profiling-output", "No path specified for --profiling-output",
     CommandArgument::Values::One,
@@ -1488,25 +1557,32 @@ void cmake::SetArgs(std::vector<std::string> const& args)
   }
 
 #if !defined(CMAKE_BOOTSTRAP)
-  if (!profilingOutput.empty() || !profilingFormat.empty()) {
+  if (!profilingOutput.empty() || !profilingFormat.empty() ||
+      profilingMemory) {
     if (profilingOutput.empty()) {
       cmSystemTools::Error(
-        "--profiling-format specified but no --profiling-output!");
+        cmStrCat(profilingFormat.empty() ? "--profiling-memory"
+                                         : "--profiling-format",
+                 " specified but no --profiling-output!"));
       return;
     }
+    cm::optional<cmMakefileProfilingData::Format> format;
     if (profilingFormat == "google-trace"_s) {
-      try {
-        this->ProfilingOutput =
-          cm::make_unique<cmMakefileProfilingData>(profilingOutput);
-      } catch (std::runtime_error& e) {
-        cmSystemTools::Error(
-          cmStrCat("Could not start profiling: ", e.what()));
-        return;
-      }
+      format = cmMakefileProfilingData::Format::GoogleTrace;
+    } else if (profilingFormat == "folded-stack"_s) {
+      format = cmMakefileProfilingData::Format::FoldedStack;
     } else {
       cmSystemTools::Error("Invalid format specified for --profiling-format");
       return;
     }
+    try {
+      this->ProfilingOutput =
+        cm::make_unique<cmMakefileProfilingData>(profilingOutput, *format,
+                                                 profilingMemory);
+    } catch (std::runtime_error& e) {
+      cmSystemTools::Error(cmStrCat("Could not start profiling: ", e.what()));
+      return;
+    }
   }
 #endif
 
@@ -2928,6 +3004,13 @@ int cmake::Run(std::vector<std::string> const& args, bool noconfigure)
     return 0;
   }
 
+  // If we are asked to check the build system and nothing changed since a
+  // previous check found it up to date, skip loading the cache.
+  if (!this->CheckBuildSystemArgument.empty() && !this->ClearBuildSystem &&
+      this->CheckBuildSystemStampIsCurrent()) {
+    return 0;
+  }
+
   if (this->GetWorkingMode() == NORMAL_MODE) {
     if (this->FreshCache) {
       this->DeleteCache(this->GetHomeOutputDirectory());
@@ -3142,6 +3225,11 @@ std::string const& cmake::GetGlobVerifyScript() const
   return this->State->GetGlobVerifyScript();
 }
 
+std::string const& cmake::GetGlobVerifyData() const
+{
+  return this->State->GetGlobVerifyData();
+}
+
 std::string const& cmake::GetGlobVerifyStamp() const
 {
   return this->State->GetGlobVerifyStamp();
@@ -3478,61 +3566,115 @@ int cmake::CheckBuildSystem()
     return 1;
   }
 
+  // Load the times of all dependencies and outputs together.
+  std::vector<std::string> checked;
+  checked.reserve(depends.size() + outputs.size());
+  checked.insert(checked.end(), depends.begin(), depends.end());
+  checked.insert(checked.end(), outputs.begin(), outputs.end());
+  std::vector<cmFileTime> times;
+  std::size_t const missing = cmakeLoadFileTimes(checked, times);
+  if (missing < checked.size()) {
+    if (verbose) {
+      cmSystemTools::Stdout(missing < depends.size()
+                              ? "Re-run cmake: build system dependency is "
+                                "missing\n"
+                              : "Re-run cmake: build system output is "
+                                "missing\n");
+    }
+    return 1;
+  }
+
   // Find the newest dependency.
-  auto dep = depends.begin();
-  std::string dep_newest = *dep++;
-  for (; dep != depends.end(); ++dep) {
-    int result = 0;
-    if (this->FileTimeCache->Compare(dep_newest, *dep, &result)) {
-      if (result < 0) {
-        dep_newest = *dep;
-      }
-    } else {
-      if (verbose) {
-        cmSystemTools::Stdout(
-          "Re-run cmake: build system dependency is missing\n");
-      }
-      return 1;
+  std::size_t dep_newest = 0;
+  for (std::size_t i = 1; i < depends.size(); ++i) {
+    if (times[dep_newest].Older(times[i])) {
+      dep_newest = i;
     }
   }
 
   // Find the oldest output.
-  auto out = outputs.begin();
-  std::string out_oldest = *out++;
-  for (; out != outputs.end(); ++out) {
-    int result = 0;
-    if (this->FileTimeCache->Compare(out_oldest, *out, &result)) {
-      if (result > 0) {
-        out_oldest = *out;
-      }
-    } else {
-      if (verbose) {
-        cmSystemTools::Stdout(
-          "Re-run cmake: build system output is missing\n");
-      }
-      return 1;
+  std::size_t out_oldest = depends.size();
+  for (std::size_t i = out_oldest + 1; i < checked.size(); ++i) {
+    if (times[out_oldest].Newer(times[i])) {
+      out_oldest = i;
     }
   }
 
   // If any output is older than any dependency then rerun.
-  {
-    int result = 0;
-    if (!this->FileTimeCache->Compare(out_oldest, dep_newest, &result) ||
-        result < 0) {
-      if (verbose) {
-        std::ostringstream msg;
-        msg << "Re-run cmake file: " << out_oldest
-            << " older than: " << dep_newest << '\n';
-        cmSystemTools::Stdout(msg.str());
-      }
-      return 1;
+  if (times[out_oldest].Older(times[dep_newest])) {
+    if (verbose) {
+      std::ostringstream msg;
+      msg << "Re-run cmake file: " << checked[out_oldest]
+          << " older than: " << checked[dep_newest] << '\n';
+      cmSystemTools::Stdout(msg.str());
     }
+    return 1;
   }
 
   // No need to rerun.
+  std::vector<std::string> files;
+  files.reserve(1 + products.size() + depends.size() + outputs.size());
+  files.emplace_back(this->CheckBuildSystemArgument);
+  files.insert(files.end(), products.begin(), products.end());
+  files.insert(files.end(), depends.begin(), depends.end());
+  files.insert(files.end(), outputs.begin(), outputs.end());
+  this->WriteCheckBuildSystemStamp(files);
   return 0;
 }
 
+std::string cmake::GetCheckBuildSystemStamp() const
+{
+  return cmStrCat(this->CheckBuildSystemArgument, ".stamp");
+}
+
+bool cmake::CheckBuildSystemStampIsCurrent() const
+{
+  // Each line holds a modification time and the path it was recorded for.
+  cmsys::ifstream fin(this->GetCheckBuildSystemStamp().c_str());
+  if (!fin) {
+    return false;
+  }
+  std::vector<std::string> files;
+  std::vector<std::string> recorded;
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    std::string::size_type const space = line.find(' ');
+    if (space == std::string::npos) {
+      return false;
+    }
+    recorded.emplace_back(line.substr(0, space));
+    files.emplace_back(line.substr(space + 1));
+  }
+  if (files.empty()) {
+    return false;
+  }
+  std::vector<cmFileTime> times;
+  if (cmakeLoadFileTimes(files, times) < files.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    if (std::to_string(times[i].GetTime()) != recorded[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void cmake::WriteCheckBuildSystemStamp(
+  std::vector<std::string> const& files) const
+{
+  std::vector<cmFileTime> times;
+  if (cmakeLoadFileTimes(files, times) < files.size()) {
+    return;
+  }
+  std::string content;
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    content += cmStrCat(times[i].GetTime(), ' ', files[i], '\n');
+  }
+  cmGeneratedFileStream fout(this->GetCheckBuildSystemStamp());
+  fout << content;
+}
+
 void cmake::TruncateOutputLog(char const* fname)
 {
   std::string fullPath = cmStrCat(this->GetHomeOutputDirectory(), '/', fname);
@@ -366,6 +366,7 @@ public:
 
   bool DoWriteGlobVerifyTarget() const;
   std::string const& GetGlobVerifyScript() const;
+  std::string const& GetGlobVerifyData() const;
   std::string const& GetGlobVerifyStamp() const;
   void AddGlobCacheEntry(cmGlobCacheEntry const& entry,
                          std::string const& variable,
@@ -787,6 +788,15 @@ protected:
    */
   int CheckBuildSystem();
 
+  /**
+   * The stamp records the files, and their modification times, that a
+   * previous CheckBuildSystem found to be up to date.
+   */
+  std::string GetCheckBuildSystemStamp() const;
+  bool CheckBuildSystemStampIsCurrent() const;
+  void WriteCheckBuildSystemStamp(
+    std::vector<std::string> const& files) const;
+
   bool SetDirectoriesFromFile(std::string const& arg);
 
   //! Make sure all commands are what they say they are and there is no
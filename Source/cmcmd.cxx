@@ -15,6 +15,7 @@
 #include "cmCommandLineArgument.h"
 #include "cmCryptoHash.h"
 #include "cmDuration.h"
+#include "cmGlobVerificationManager.h"
 #include "cmGlobalGenerator.h"
 #include "cmList.h"
 #include "cmLocalGenerator.h"
@@ -1482,6 +1483,11 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
       return cmcmd::ExecuteEchoColor(args);
     }
 
+    // Internal CMake glob verification support.
+    if (args[1] == "cmake_verify_globs" && args.size() == 3) {
+      return cmGlobVerificationManager::VerifyGlobs(args[2]) ? 0 : 1;
+    }
+
 #ifndef CMAKE_BOOTSTRAP
     if ((args[1] == "cmake_autogen") && (args.size() >= 4)) {
       cm::string_view const infoFile = args[2];
@@ -1734,21 +1740,33 @@ int cmcmd::HashSumFile(std::vector<std::string> const& args,
   }
   int retval = 0;
 
-  for (auto const& filename : cmMakeRange(args).advance(2)) {
-    // Cannot compute sum of a directory
-    if (cmSystemTools::FileIsDirectory(filename)) {
+  // Cannot compute sum of a directory
+  auto const filenames = cmMakeRange(args).advance(2);
+  std::vector<bool> isDirectory;
+  std::vector<std::string> files;
+  for (auto const& filename : filenames) {
+    isDirectory.push_back(cmSystemTools::FileIsDirectory(filename));
+    if (!isDirectory.back()) {
+      files.push_back(filename);
+    }
+  }
+
+  // The files are read concurrently and reported in order.
+  cmCryptoHash hasher(algo);
+  std::vector<std::string> const values = hasher.HashFiles(files);
+  auto value = values.begin();
+  auto directory = isDirectory.begin();
+  for (auto const& filename : filenames) {
+    if (*directory++) {
       std::cerr << "Error: " << filename << " is a directory\n";
       retval++;
+    } else if (value->empty()) {
+      // To mimic "md5sum/shasum" behavior in a shell:
+      std::cerr << filename << ": No such file or directory\n";
+      retval++;
+      ++value;
     } else {
-      cmCryptoHash hasher(algo);
-      std::string value = hasher.HashFile(filename);
-      if (value.empty()) {
-        // To mimic "md5sum/shasum" behavior in a shell:
-        std::cerr << filename << ": No such file or directory\n";
-        retval++;
-      } else {
-        std::cout << value << "  " << filename << '\n';
-      }
+      std::cout << *value++ << "  " << filename << '\n';
     }
   }
   return retval;
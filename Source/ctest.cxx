@@ -204,6 +204,11 @@ int main(int argc, char const* const* argv)
       cmInstrumentationQuery::Hook::Manual);
   }
 
+  // Dispatch 'ctest --summarize-instrumentation' mode directly.
+  if (argc == 3 && strcmp(argv[1], "--summarize-instrumentation") == 0) {
+    return cmInstrumentation::SummarizeTimingData(argv[2]);
+  }
+
   if (cmSystemTools::GetLogicalWorkingDirectory().empty()) {
     std::cerr << "Current working directory cannot be established.\n";
     return 1;
@@ -0,0 +1,205 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <cstdint>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmCacheManager.h"
+#include "cmFileTimes.h"
+#include "cmStateTypes.h"
+#include "cmSystemTools.h"
+#include "cmValue.h"
+
+#include "testCommon.h"
+
+namespace {
+
+std::string const cacheDir = "testCacheManagerDir";
+std::string const binaryCache = cacheDir + "/CMakeFiles/CMakeCache.bin";
+
+bool loadCache(cmCacheManager& cache)
+{
+  std::set<std::string> excludes;
+  std::set<std::string> includes;
+  return cache.LoadCache(cacheDir, true, excludes, includes);
+}
+
+bool saveCache()
+{
+  cmSystemTools::RemoveADirectory(cacheDir);
+  cmSystemTools::MakeDirectory(cacheDir);
+
+  cmCacheManager cache;
+  cache.AddCacheEntry("PLAIN", "value", "A plain entry",
+                      cmStateEnums::STRING);
+  cache.AddCacheEntry("TRAILING", "value ", "Trailing space",
+                      cmStateEnums::STRING);
+  cache.AddCacheEntry("WITH:COLON", "ON", "Key with a colon",
+                      cmStateEnums::BOOL);
+  cache.AddCacheEntry("HIDDEN", "internal", "", cmStateEnums::INTERNAL);
+  cache.SetCacheEntryBoolProperty("PLAIN", "ADVANCED", true);
+  return cache.SaveCache(cacheDir, nullptr);
+}
+
+bool checkEntries(cmCacheManager const& cache, std::string const& plain)
+{
+  ASSERT_EQUAL(*cache.GetCacheEntryValue("PLAIN"), plain);
+  ASSERT_EQUAL(*cache.GetCacheEntryValue("TRAILING"), "value ");
+  ASSERT_EQUAL(*cache.GetCacheEntryValue("WITH:COLON"), "ON");
+  ASSERT_EQUAL(*cache.GetCacheEntryValue("HIDDEN"), "internal");
+  ASSERT_EQUAL(cache.GetCacheEntryType("WITH:COLON"), cmStateEnums::BOOL);
+  ASSERT_EQUAL(*cache.GetCacheEntryProperty("TRAILING", "HELPSTRING"),
+               "Trailing space");
+  ASSERT_TRUE(cache.GetCacheEntryPropertyAsBool("PLAIN", "ADVANCED"));
+  return true;
+}
+
+std::string const textCache = cacheDir + "/CMakeCache.txt";
+
+std::string readText()
+{
+  cmsys::ifstream fin(textCache.c_str());
+  std::ostringstream contents;
+  contents << fin.rdbuf();
+  return contents.str();
+}
+
+void writeText(std::string const& text)
+{
+  cmsys::ofstream fout(textCache.c_str());
+  fout << text;
+}
+
+bool testRoundTrip()
+{
+  std::cout << "testRoundTrip()\n";
+
+  ASSERT_TRUE(saveCache());
+  ASSERT_TRUE(cmSystemTools::FileExists(binaryCache));
+
+  cmCacheManager cache;
+  ASSERT_TRUE(loadCache(cache));
+  return checkEntries(cache, "value");
+}
+
+bool testEditedText()
+{
+  std::cout << "testEditedText()\n";
+
+  ASSERT_TRUE(saveCache());
+
+  // Edits to CMakeCache.txt make the binary cache stale.
+  std::string text = readText();
+  ASSERT_TRUE(text.find("PLAIN:STRING=value\n") != std::string::npos);
+  cmSystemTools::ReplaceString(text, "PLAIN:STRING=value\n",
+                               "PLAIN:STRING=edited\n");
+  writeText(text);
+  cmCacheManager cache;
+  ASSERT_TRUE(loadCache(cache));
+  return checkEntries(cache, "edited");
+}
+
+bool testSameSizeEdit()
+{
+  std::cout << "testSameSizeEdit()\n";
+
+  ASSERT_TRUE(saveCache());
+
+  // An edit keeping the size and modification time of CMakeCache.txt,
+  // as one within the file system time resolution may, is still seen.
+  cmFileTimes const times(textCache);
+  std::string text = readText();
+  cmSystemTools::ReplaceString(text, "PLAIN:STRING=value\n",
+                               "PLAIN:STRING=VALUE\n");
+  writeText(text);
+  ASSERT_TRUE(times.Store(textCache));
+  {
+    cmCacheManager cache;
+    ASSERT_TRUE(loadCache(cache));
+    ASSERT_TRUE(checkEntries(cache, "VALUE"));
+
+    // Saving the loaded cache keeps the edit.
+    ASSERT_TRUE(cache.SaveCache(cacheDir, nullptr));
+  }
+  cmCacheManager cache;
+  ASSERT_TRUE(loadCache(cache));
+  return checkEntries(cache, "VALUE");
+}
+
+bool testBinaryUsed()
+{
+  std::cout << "testBinaryUsed()\n";
+
+  ASSERT_TRUE(saveCache());
+
+  // Change the value of PLAIN in the binary form only.  Loading the cache
+  // must then give the changed value, since CMakeCache.txt is unchanged.
+  std::string binary;
+  {
+    cmsys::ifstream fin(binaryCache.c_str(), std::ios::in | std::ios::binary);
+    std::ostringstream contents;
+    contents << fin.rdbuf();
+    binary = contents.str();
+  }
+  std::uint32_t const size = 5;
+  std::string const prefix(reinterpret_cast<char const*>(&size),
+                           sizeof(size));
+  std::string::size_type const pos = binary.find(prefix + "value");
+  ASSERT_TRUE(pos != std::string::npos);
+  binary.replace(pos + prefix.size(), size, "saved");
+  {
+    cmsys::ofstream fout(binaryCache.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::trunc);
+    fout << binary;
+  }
+  cmCacheManager cache;
+  ASSERT_TRUE(loadCache(cache));
+  return checkEntries(cache, "saved");
+}
+
+bool testValueWithNewline()
+{
+  std::cout << "testValueWithNewline()\n";
+
+  ASSERT_TRUE(saveCache());
+
+  // CMakeCache.txt keeps only the first line of a value, so no binary
+  // cache is written and loading parses the text.
+  {
+    cmCacheManager cache;
+    ASSERT_TRUE(loadCache(cache));
+    cache.AddCacheEntry("PLAIN", "multi\nline", "A plain entry",
+                        cmStateEnums::STRING);
+    ASSERT_TRUE(cache.SaveCache(cacheDir, nullptr));
+  }
+  ASSERT_TRUE(!cmSystemTools::FileExists(binaryCache));
+  cmCacheManager cache;
+  ASSERT_TRUE(loadCache(cache));
+  return checkEntries(cache, "multi");
+}
+
+bool testCorruptBinary()
+{
+  std::cout << "testCorruptBinary()\n";
+
+  ASSERT_TRUE(saveCache());
+  {
+    cmsys::ofstream fout(binaryCache.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::app);
+    fout << "garbage";
+  }
+  cmCacheManager cache;
+  ASSERT_TRUE(loadCache(cache));
+  return checkEntries(cache, "value");
+}
+}
+
+int testCacheManager(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({ testRoundTrip, testEditedText, testSameSizeEdit,
+                    testBinaryUsed, testValueWithNewline, testCorruptBinary });
+}
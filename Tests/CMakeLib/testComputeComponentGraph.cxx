@@ -0,0 +1,116 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <cstddef>
+#include <vector>
+
+#include "cmComputeComponentGraph.h"
+#include "cmGraphAdjacencyList.h"
+#include "cmListFileCache.h"
+
+#include "testCommon.h"
+
+namespace {
+
+void addEdge(cmGraphAdjacencyList& graph, size_t from, size_t to)
+{
+  graph[from].emplace_back(to, false, false, cmListFileBacktrace());
+}
+
+bool testSmallGraph()
+{
+  std::cout << "testSmallGraph()\n";
+
+  // 0 -> 1 -> 2 -> 1, 2 -> 3, 4 alone
+  cmGraphAdjacencyList graph;
+  graph.resize(5);
+  addEdge(graph, 0, 1);
+  addEdge(graph, 1, 2);
+  addEdge(graph, 2, 1);
+  addEdge(graph, 2, 3);
+
+  cmComputeComponentGraph ccg(graph);
+  ccg.Compute();
+
+  // Components are identified in reverse topological order.
+  std::vector<cmGraphNodeList> const& components = ccg.GetComponents();
+  ASSERT_EQUAL(components.size(), 4);
+  ASSERT_TRUE(components[0] == cmGraphNodeList{ { 3 } });
+  ASSERT_TRUE((components[1] == cmGraphNodeList{ { 1, 2 } }));
+  ASSERT_TRUE(components[2] == cmGraphNodeList{ { 0 } });
+  ASSERT_TRUE(components[3] == cmGraphNodeList{ { 4 } });
+
+  std::vector<size_t> const& map = ccg.GetComponentMap();
+  ASSERT_EQUAL(map[1], map[2]);
+  ASSERT_EQUAL(map[4], 3);
+
+  // Edges between components are kept with their multiplicity.
+  cmGraphEdgeList const& edges = ccg.GetComponentGraphEdges(map[0]);
+  ASSERT_EQUAL(edges.size(), 1);
+  ASSERT_EQUAL(static_cast<size_t>(edges[0]), map[1]);
+  ASSERT_EQUAL(ccg.GetComponentGraphEdges(map[1]).size(), 1);
+  ASSERT_TRUE(ccg.GetComponentGraphEdges(map[3]).empty());
+
+  return true;
+}
+
+bool testLargeChain()
+{
+  std::cout << "testLargeChain()\n";
+
+  // A path deep enough to exhaust the call stack of a recursive walk.
+  size_t const n = 100000;
+  cmGraphAdjacencyList graph;
+  graph.resize(n);
+  for (size_t i = 0; i + 1 < n; ++i) {
+    addEdge(graph, i, i + 1);
+  }
+
+  cmComputeComponentGraph ccg(graph);
+  ccg.Compute();
+
+  ASSERT_EQUAL(ccg.GetComponents().size(), n);
+  ASSERT_EQUAL(ccg.GetComponentMap()[n - 1], 0);
+  ASSERT_EQUAL(ccg.GetComponentMap()[0], n - 1);
+  return true;
+}
+
+bool testLargeCycles()
+{
+  std::cout << "testLargeCycles()\n";
+
+  // Rings of 1000 nodes with extra chords, linked one after the other.
+  size_t const ring = 1000;
+  size_t const rings = 100;
+  cmGraphAdjacencyList graph;
+  graph.resize(ring * rings);
+  for (size_t r = 0; r < rings; ++r) {
+    size_t const base = r * ring;
+    for (size_t i = 0; i < ring; ++i) {
+      addEdge(graph, base + i, base + (i + 1) % ring);
+      addEdge(graph, base + i, base + (i * 7 + 3) % ring);
+    }
+    if (r + 1 < rings) {
+      addEdge(graph, base, base + ring);
+    }
+  }
+
+  cmComputeComponentGraph ccg(graph);
+  ccg.Compute();
+
+  std::vector<cmGraphNodeList> const& components = ccg.GetComponents();
+  ASSERT_EQUAL(components.size(), rings);
+  for (size_t c = 0; c < rings; ++c) {
+    ASSERT_EQUAL(components[c].size(), ring);
+    // The last ring is completed first.
+    ASSERT_EQUAL(components[c].front(), (rings - 1 - c) * ring);
+    ASSERT_EQUAL(ccg.GetComponentGraphEdges(c).size(), c == 0 ? 0 : 1);
+  }
+  return true;
+}
+}
+
+int testComputeComponentGraph(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({ testSmallGraph, testLargeChain, testLargeCycles });
+}
@@ -0,0 +1,171 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <cm/memory>
+
+#include "cmGlobalGenerator.h"
+#include "cmListFileCache.h"
+#include "cmMakefile.h"
+#include "cmState.h"
+#include "cmStateDirectory.h"
+#include "cmStateSnapshot.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmake.h"
+
+#include "testCommon.h"
+
+namespace {
+
+class Script
+{
+public:
+  Script()
+    : CMake(cmake::RoleScript, cmState::Script)
+    , GlobalGenerator(&this->CMake)
+  {
+    std::string const cwd = cmSystemTools::GetLogicalWorkingDirectory();
+    cmStateSnapshot snapshot = this->CMake.GetCurrentSnapshot();
+    snapshot.GetDirectory().SetCurrentSource(cwd);
+    snapshot.GetDirectory().SetCurrentBinary(cwd);
+    snapshot.SetDefaultDefinitions();
+    this->Makefile =
+      cm::make_unique<cmMakefile>(&this->GlobalGenerator, snapshot);
+  }
+
+  bool Run(std::string const& code)
+  {
+    return this->Makefile->ReadListFileAsString(code, "test.cmake") &&
+      !cmSystemTools::GetFatalErrorOccurred();
+  }
+
+  std::string const& Get(std::string const& name) const
+  {
+    return this->Makefile->GetSafeDefinition(name);
+  }
+
+private:
+  cmake CMake;
+  cmGlobalGenerator GlobalGenerator;
+  std::unique_ptr<cmMakefile> Makefile;
+};
+
+bool testExpansion()
+{
+  std::cout << "testExpansion()\n";
+
+  Script script;
+  ASSERT_TRUE(script.Run(R"(
+function(count)
+  set(n ${ARGC} PARENT_SCOPE)
+endfunction()
+set(v "1;2")
+set(plain a "b c" d;e)
+count(${v})
+set(unquoted ${n})
+count("${v}")
+set(quoted ${n})
+count(${undefined})
+set(undefined ${n})
+count(${v}x)
+set(suffixed ${n})
+count(\${v})
+set(escaped ${n})
+set(line ${CMAKE_CURRENT_LIST_LINE})
+)"));
+  ASSERT_EQUAL(script.Get("plain"), "a;b c;d;e");
+  ASSERT_EQUAL(script.Get("unquoted"), "2");
+  ASSERT_EQUAL(script.Get("quoted"), "1");
+  ASSERT_EQUAL(script.Get("undefined"), "0");
+  ASSERT_EQUAL(script.Get("suffixed"), "2");
+  ASSERT_EQUAL(script.Get("escaped"), "1");
+  ASSERT_EQUAL(script.Get("line"), "17");
+  return true;
+}
+
+bool testTemplates()
+{
+  std::cout << "testTemplates()\n";
+
+  using Template = cmListFileArgumentTemplate;
+  auto const tpl = Template::Parse("a${b}\\t$ENV{c}\\;$CACHE{d}\\$<e>$");
+  ASSERT_TRUE(tpl);
+  ASSERT_EQUAL(tpl->Segments.size(), 7);
+  ASSERT_TRUE(tpl->Segments[0].Kind == Template::Literal);
+  ASSERT_EQUAL(tpl->Segments[0].Text, "a");
+  ASSERT_TRUE(tpl->Segments[1].Kind == Template::Variable);
+  ASSERT_EQUAL(tpl->Segments[1].Text, "b");
+  ASSERT_EQUAL(tpl->Segments[2].Text, "\t");
+  ASSERT_TRUE(tpl->Segments[3].Kind == Template::EnvironmentVariable);
+  ASSERT_EQUAL(tpl->Segments[3].Text, "c");
+  ASSERT_EQUAL(tpl->Segments[4].Text, "\\;");
+  ASSERT_TRUE(tpl->Segments[5].Kind == Template::CacheVariable);
+  ASSERT_EQUAL(tpl->Segments[5].Text, "d");
+  ASSERT_EQUAL(tpl->Segments[6].Text, "$<e>$");
+
+  // Left to the general expansion.
+  ASSERT_TRUE(!Template::Parse("plain"));
+  ASSERT_TRUE(!Template::Parse("${${a}}"));
+  ASSERT_TRUE(!Template::Parse("${CMAKE_CURRENT_LIST_LINE}"));
+  ASSERT_TRUE(!Template::Parse("${a"));
+  ASSERT_TRUE(!Template::Parse("${a b}"));
+  ASSERT_TRUE(!Template::Parse("\\x"));
+  ASSERT_TRUE(!Template::Parse("$FOO{a}"));
+
+  Script script;
+  ASSERT_TRUE(script.Run(R"(
+set(a "A")
+set(b "x;y")
+set(ENV{TPL_ENV} "E")
+set(c "C" CACHE STRING "")
+set(r1 "pre${a}mid${b}post")
+set(r2 pre${a}\t${b}\;z)
+set(r3 "$ENV{TPL_ENV}-$CACHE{c}-${c}")
+set(r4 "$<1:${a}>$")
+set(A "nested")
+set(r5 "${${a}}x")
+set(r6 "\${a}\\\"")
+)"));
+  ASSERT_EQUAL(script.Get("r1"), "preAmidx;ypost");
+  ASSERT_EQUAL(script.Get("r2"), "preA\tx;y;z");
+  ASSERT_EQUAL(script.Get("r3"), "E-C-C");
+  ASSERT_EQUAL(script.Get("r4"), "$<1:A>$");
+  ASSERT_EQUAL(script.Get("r5"), "nestedx");
+  ASSERT_EQUAL(script.Get("r6"), "${a}\\\"");
+  return true;
+}
+
+bool testDispatchLoop()
+{
+  std::cout << "testDispatchLoop()\n";
+
+  // Run commands with the kinds of arguments found in typical scripts
+  // many times over.
+  int const iterations = 1000;
+  std::string const code = cmStrCat("set(items \"\")\n"
+                                    "foreach(i RANGE 1 ",
+                                    iterations,
+                                    ")\n"
+                                    "  set(name \"item${i}\")\n"
+                                    "  if(name STREQUAL \"\")\n"
+                                    "  endif()\n"
+                                    "  list(APPEND items ${name})\n"
+                                    "endforeach()\n"
+                                    "list(LENGTH items length)\n"
+                                    "list(GET items -1 last)\n");
+  Script script;
+  ASSERT_TRUE(script.Run(code));
+  ASSERT_EQUAL(script.Get("length"), std::to_string(iterations));
+  ASSERT_EQUAL(script.Get("last"), cmStrCat("item", iterations));
+  return true;
+}
+}
+
+int testExpandArguments(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({ testExpansion, testTemplates, testDispatchLoop });
+}
@@ -0,0 +1,178 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "cmsys/RegularExpression.hxx"
+
+#include "cmLinearRegularExpression.h"
+
+#include "testCommon.h"
+
+namespace {
+
+// Compare every match of both engines, as string(REGEX MATCHALL) does.
+bool sameMatches(std::string const& pattern, std::string const& input,
+                 unsigned options)
+{
+  cmsys::RegularExpression expected;
+  cmLinearRegularExpression actual;
+  bool const valid = expected.compile(pattern);
+  if (actual.compile(pattern) != valid) {
+    std::cout << "pattern \"" << pattern << "\" validity differs\n";
+    return false;
+  }
+  if (!valid) {
+    return true;
+  }
+
+  std::string::size_type base = 0;
+  unsigned nonEmpty = 0;
+  for (;;) {
+    bool const found = expected.find(input, base, options | nonEmpty);
+    if (actual.find(input, base, options | nonEmpty) != found) {
+      std::cout << "pattern \"" << pattern << "\" on \"" << input
+                << "\" at " << base << " finds differently\n";
+      return false;
+    }
+    if (!found) {
+      return true;
+    }
+    for (int n = 0; n <= expected.num_groups(); ++n) {
+      if (actual.start(n) != expected.start(n) ||
+          actual.match(n) != expected.match(n)) {
+        std::cout << "pattern \"" << pattern << "\" on \"" << input
+                  << "\" group " << n << " is \"" << actual.match(n)
+                  << "\", expected \"" << expected.match(n) << "\"\n";
+        return false;
+      }
+    }
+    base = expected.end();
+    if (expected.start() == input.length()) {
+      return true;
+    }
+    nonEmpty = 0;
+    if (expected.start() == expected.end()) {
+      nonEmpty = cmsys::RegularExpression::NONEMPTY_AT_OFFSET;
+    }
+  }
+}
+
+bool testSameAsBacktracking()
+{
+  std::cout << "testSameAsBacktracking()\n";
+
+  std::vector<std::string> const patterns = {
+    "",
+    "a",
+    "abc",
+    "^abc",
+    "abc$",
+    "^$",
+    "$",
+    "b*$",
+    "a*",
+    "a+b",
+    "ab?c",
+    "a|b|",
+    "(a|ab)(c|bcd)(d*)",
+    "(a+)(b+)?",
+    "((a)|b)+",
+    "(a*)b",
+    "x*",
+    "[a-c]+",
+    "[^a-c]+",
+    "[]a]",
+    "[^]a]+",
+    "[-a]+",
+    "[a-]+",
+    "[a-c-e]+",
+    ".",
+    ".*c",
+    "\\.\\*",
+    "(.*)=(.*)",
+    "^([A-Za-z_][A-Za-z0-9_]*)[ \t]*\\(",
+    "#[ \t]*include[ \t]*[<\"]([^>\"]+)[>\"]",
+    "(a|b)*c",
+    "(ab|a)(bc|c)?",
+    "((a?)b)+",
+    // Invalid patterns.
+    "(",
+    ")",
+    "a**",
+    "*a",
+    "(a*)*",
+    "[z-a]",
+    "[abc",
+    "a\\",
+  };
+  std::vector<std::string> const inputs = {
+    "",
+    "a",
+    "abc",
+    "xabcx abc",
+    "aabbcc",
+    "abcd abcbcd",
+    "abababc",
+    "]a]b",
+    "-a-b",
+    "a.*b.*",
+    "name = value = other",
+    "int main(void)\nfoo (x)",
+    "#include <foo.h>\n# include \"bar.h\"",
+    "bbbc",
+    "xyz",
+  };
+  for (std::string const& pattern : patterns) {
+    for (std::string const& input : inputs) {
+      ASSERT_TRUE(sameMatches(pattern, input, 0));
+      ASSERT_TRUE(sameMatches(pattern, input,
+                              cmsys::RegularExpression::BOL_AT_OFFSET));
+    }
+  }
+  return true;
+}
+
+bool testLongInput()
+{
+  std::cout << "testLongInput()\n";
+
+  // Stops at the first null character, as cmsys does.
+  cmLinearRegularExpression regex("b$");
+  ASSERT_TRUE(regex.find(std::string("ab\0c", 4)));
+  ASSERT_EQUAL(regex.start(), 1);
+
+  std::string input(100000, 'x');
+  input += "needle";
+  ASSERT_TRUE(regex.compile("ne+dle"));
+  ASSERT_TRUE(regex.find(input));
+  ASSERT_EQUAL(regex.start(), 100000);
+  ASSERT_TRUE(!regex.find(input, 100001));
+  return true;
+}
+
+bool testPathological()
+{
+  std::cout << "testPathological()\n";
+
+  // A backtracking matcher tries every way to split the input between
+  // the alternatives before failing, which takes exponential time.
+  std::string const input(64, 'a');
+  auto const begin = std::chrono::steady_clock::now();
+  cmLinearRegularExpression regex("^(a|aa)+$b");
+  ASSERT_TRUE(regex.is_valid());
+  ASSERT_TRUE(!regex.find(input));
+  ASSERT_TRUE(regex.compile("(a|aa)+c"));
+  ASSERT_TRUE(!regex.find(input));
+  auto const elapsed = std::chrono::steady_clock::now() - begin;
+  ASSERT_TRUE(elapsed < std::chrono::seconds(5));
+  return true;
+}
+}
+
+int testLinearRegularExpression(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({ testSameAsBacktracking, testLongInput, testPathological });
+}
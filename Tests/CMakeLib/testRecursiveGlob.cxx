@@ -0,0 +1,121 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cmsys/Glob.hxx"
+
+#include "cmRecursiveGlob.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+#include "testCommon.h"
+
+namespace {
+
+std::string const root =
+  cmStrCat(cmSystemTools::GetLogicalWorkingDirectory(), "/testRecursiveGlob");
+
+void touch(std::string const& path)
+{
+  cmSystemTools::Touch(path, true);
+}
+
+// Enough directories for the walk to continue on several threads.
+void makeTree()
+{
+  cmSystemTools::RemoveADirectory(root);
+  for (int i = 0; i < 100; ++i) {
+    std::string const dir = cmStrCat(root, "/sub", i, "/deep/er");
+    cmSystemTools::MakeDirectory(dir);
+    touch(cmStrCat(root, "/sub", i, "/a.c"));
+    touch(cmStrCat(dir, "/b.c"));
+    touch(cmStrCat(dir, "/x.h"));
+  }
+  cmSystemTools::MakeDirectory(cmStrCat(root, "/empty"));
+  touch(cmStrCat(root, "/top.c"));
+  cmSystemTools::CreateSymlinkQuietly("sub1", cmStrCat(root, "/link_dir.c"));
+  cmSystemTools::CreateSymlinkQuietly("top.c", cmStrCat(root, "/link_file.c"));
+  cmSystemTools::CreateSymlinkQuietly("missing",
+                                     cmStrCat(root, "/dangling.c"));
+}
+
+bool sameFiles(std::string const& expr, bool listDirs,
+               std::string const& relative)
+{
+  cmsys::Glob expected;
+  expected.SetRecurse(true);
+  expected.RecurseThroughSymlinksOff();
+  expected.SetRecurseListDirs(listDirs);
+  expected.SetRelative(relative.empty() ? nullptr : relative.c_str());
+  expected.FindFiles(expr);
+  std::vector<std::string> expectedFiles = expected.GetFiles();
+  std::sort(expectedFiles.begin(), expectedFiles.end());
+
+  cmRecursiveGlob actual;
+  actual.SetJobs(4);
+  actual.SetListDirectories(listDirs);
+  actual.SetRelative(relative);
+  if (!actual.FindFiles(expr)) {
+    std::cout << "expression \"" << expr << "\" not supported\n";
+    return false;
+  }
+  std::vector<std::string> actualFiles = actual.GetFiles();
+  std::sort(actualFiles.begin(), actualFiles.end());
+
+  if (actualFiles != expectedFiles) {
+    std::cout << "expression \"" << expr << "\" found " << actualFiles.size()
+              << " files, expected " << expectedFiles.size() << '\n';
+    return false;
+  }
+  return true;
+}
+
+bool testSameAsGlob()
+{
+  std::cout << "testSameAsGlob()\n";
+
+  makeTree();
+  std::vector<std::string> const exprs = {
+    cmStrCat(root, "/*"),
+    cmStrCat(root, "/*.c"),
+    cmStrCat(root, "/*/*.c"),
+    cmStrCat(root, "/sub1*/*.h"),
+    cmStrCat(root, "/sub?/de*/x*"),
+    cmStrCat(root, "/top.c"),
+    cmStrCat(root, "/sub[0-4]/er/*"),
+    cmStrCat(root, "/missing/*"),
+    cmStrCat(root, "//sub2//*.c"),
+  };
+  for (std::string const& expr : exprs) {
+    ASSERT_TRUE(sameFiles(expr, false, ""));
+    ASSERT_TRUE(sameFiles(expr, true, ""));
+    ASSERT_TRUE(sameFiles(expr, false, root));
+  }
+  cmSystemTools::RemoveADirectory(root);
+  return true;
+}
+
+bool testUnsupported()
+{
+  std::cout << "testUnsupported()\n";
+
+  cmRecursiveGlob glob;
+  ASSERT_TRUE(!glob.FindFiles("relative/*.c"));
+  ASSERT_TRUE(!glob.FindFiles("/escaped\\*/*.c"));
+  ASSERT_TRUE(!glob.FindFiles("/"));
+  return true;
+}
+}
+
+int testRecursiveGlob(int /*unused*/, char* /*unused*/[])
+{
+#if defined(_WIN32) || defined(__CYGWIN__)
+  return 0;
+#else
+  return runTests({ testSameAsGlob, testUnsupported });
+#endif
+}
@@ -0,0 +1,82 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <cstddef>
+#include <string>
+
+#include "cmsys/RegularExpression.hxx"
+
+#include "cmRegularExpressionCache.h"
+
+#include "testCommon.h"
+
+namespace {
+
+bool testReuse()
+{
+  std::cout << "testReuse()\n";
+
+  cmRegularExpressionCache::Clear();
+  cmRegularExpressionCache::Statistics const before =
+    cmRegularExpressionCache::GetStatistics();
+
+  cmsys::RegularExpression* first = cmRegularExpressionCache::Get("^a(b+)");
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(first->find("abbc"));
+  ASSERT_EQUAL(first->match(1), "bb");
+
+  cmsys::RegularExpression* second = cmRegularExpressionCache::Get("^a(b+)");
+  ASSERT_TRUE(second == first);
+  ASSERT_TRUE(!second->find("cab"));
+
+  cmRegularExpressionCache::Statistics const after =
+    cmRegularExpressionCache::GetStatistics();
+  ASSERT_EQUAL(after.Hits - before.Hits, 1);
+  ASSERT_EQUAL(after.Misses - before.Misses, 1);
+  ASSERT_EQUAL(after.Size, 1);
+  return true;
+}
+
+bool testInvalid()
+{
+  std::cout << "testInvalid()\n";
+
+  cmRegularExpressionCache::Clear();
+  ASSERT_TRUE(!cmRegularExpressionCache::Get("(unmatched"));
+  ASSERT_EQUAL(cmRegularExpressionCache::GetStatistics().Size, 0);
+  return true;
+}
+
+bool testEviction()
+{
+  std::cout << "testEviction()\n";
+
+  cmRegularExpressionCache::Clear();
+  std::size_t const capacity = cmRegularExpressionCache::Capacity;
+  std::size_t const evictions =
+    cmRegularExpressionCache::GetStatistics().Evictions;
+  for (std::size_t i = 0; i <= capacity; ++i) {
+    ASSERT_TRUE(cmRegularExpressionCache::Get("x" + std::to_string(i)));
+    // Keep the first pattern recently used.
+    ASSERT_TRUE(cmRegularExpressionCache::Get("x0"));
+  }
+
+  cmRegularExpressionCache::Statistics const stats =
+    cmRegularExpressionCache::GetStatistics();
+  ASSERT_EQUAL(stats.Size, capacity);
+  ASSERT_EQUAL(stats.Evictions - evictions, 1);
+
+  // The least recently used pattern was dropped.
+  std::size_t const misses = stats.Misses;
+  ASSERT_TRUE(cmRegularExpressionCache::Get("x0"));
+  ASSERT_EQUAL(cmRegularExpressionCache::GetStatistics().Misses, misses);
+  ASSERT_TRUE(cmRegularExpressionCache::Get("x1"));
+  ASSERT_EQUAL(cmRegularExpressionCache::GetStatistics().Misses, misses + 1);
+  return true;
+}
+}
+
+int testRegularExpressionCache(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({ testReuse, testInvalid, testEviction });
+}
@@ -0,0 +1,115 @@
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+#include "cmGetPipes.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmWorkerPool.h"
+
+namespace {
+
+std::size_t const kFAILED_JOBS = 3;
+
+struct Results
+{
+  std::size_t Failed = 0;
+  std::size_t Succeeded = 0;
+};
+
+class ProcessJob : public cmWorkerPool::JobT
+{
+public:
+  ProcessJob(std::vector<std::string> command)
+    : Command(std::move(command))
+  {
+  }
+
+  void Process() override
+  {
+    cmWorkerPool::ProcessResultT result;
+    bool const success = this->RunProcess(result, this->Command, ".");
+    auto& results = *static_cast<Results*>(this->UserData());
+    if (success) {
+      ++results.Succeeded;
+    } else {
+      ++results.Failed;
+    }
+  }
+
+private:
+  std::vector<std::string> Command;
+};
+
+class EndJob : public cmWorkerPool::JobFenceT
+{
+public:
+  void Process() override { this->Pool()->Abort(); }
+};
+
+bool testFailedSpawnReleasesToken(std::string const& cmakeCommand)
+{
+  std::cout << "testFailedSpawnReleasesToken()\n";
+
+#ifndef _WIN32
+  // Create a job server pipe without tokens, so the pool owns only the
+  // implicit token.  A failed spawn that kept it would block all later
+  // processes.
+  int jobServerPipe[2];
+  if (cmGetPipes(jobServerPipe) < 0) {
+    std::cout << "Failed to create job server pipe\n";
+    return false;
+  }
+  cmSystemTools::PutEnv(cmStrCat("MAKEFLAGS=--jobserver-fds=",
+                                 jobServerPipe[0], ',', jobServerPipe[1]));
+#endif
+
+  cmWorkerPool pool;
+  pool.SetThreadCount(1);
+  pool.SetUseJobServer(true);
+  for (std::size_t i = 0; i != kFAILED_JOBS; ++i) {
+    pool.EmplaceJob<ProcessJob>(
+      std::vector<std::string>{ "testWorkerPool-no-such-command" });
+  }
+  pool.EmplaceJob<ProcessJob>(
+    std::vector<std::string>{ cmakeCommand, "-E", "true" });
+  pool.EmplaceJob<EndJob>();
+
+  Results results;
+  if (!pool.Process(&results)) {
+    std::cout << "Worker pool processing failed\n";
+    return false;
+  }
+
+#ifndef _WIN32
+  close(jobServerPipe[0]);
+  close(jobServerPipe[1]);
+#endif
+
+  if (results.Failed != kFAILED_JOBS || results.Succeeded != 1) {
+    std::cout << "Expected " << kFAILED_JOBS
+              << " failed and 1 successful process, got " << results.Failed
+              << " failed and " << results.Succeeded << " successful\n";
+    return false;
+  }
+  return true;
+}
+}
+
+int testWorkerPool(int argc, char** const argv)
+{
+  if (argc < 2) {
+    std::cout << "Invalid arguments.\n";
+    return -1;
+  }
+
+  bool passed = true;
+  passed = testFailedSpawnReleasesToken(argv[1]) && passed;
+  return passed ? 0 : -1;
+}
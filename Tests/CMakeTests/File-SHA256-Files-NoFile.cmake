@@ -0,0 +1,4 @@
+file(SHA256 FILES
+  ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt
+  ${CMAKE_CURRENT_LIST_DIR}/DoesNotExist.cmake
+  OUTPUT_VARIABLE sha256)
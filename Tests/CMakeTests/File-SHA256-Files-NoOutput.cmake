@@ -0,0 +1 @@
+file(SHA256 FILES ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt sha256)
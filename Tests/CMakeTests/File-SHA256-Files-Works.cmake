@@ -0,0 +1,12 @@
+file(SHA256 FILES
+  ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt
+  ${CMAKE_CURRENT_LIST_FILE}
+  ${CMAKE_CURRENT_LIST_DIR}/File-HASH-Input.txt
+  OUTPUT_VARIABLE sha256)
+list(GET sha256 1 self)
+file(SHA256 ${CMAKE_CURRENT_LIST_FILE} expect)
+if(NOT self STREQUAL expect)
+  message(FATAL_ERROR "Unexpected hash of ${CMAKE_CURRENT_LIST_FILE}: ${self}")
+endif()
+list(REMOVE_AT sha256 1)
+message("${sha256}")
@@ -25,6 +25,7 @@ ADD_AUTOGEN_TEST(Parallel2 parallel2)
 ADD_AUTOGEN_TEST(Parallel3 parallel3)
 ADD_AUTOGEN_TEST(Parallel4 parallel4)
 ADD_AUTOGEN_TEST(ParallelAUTO parallelAUTO)
+ADD_AUTOGEN_TEST(ParallelJobServer parallelJobServer)
 ADD_AUTOGEN_TEST(RccAutogenBuildDir)
 ADD_AUTOGEN_TEST(RccEmpty rccEmpty)
 ADD_AUTOGEN_TEST(RccOffMocLibrary)
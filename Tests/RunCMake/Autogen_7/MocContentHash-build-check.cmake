@@ -0,0 +1,12 @@
+file(GLOB_RECURSE mocFiles
+  "${RunCMake_TEST_BINARY_DIR}/moc_content_autogen/moc_moc_content.cpp")
+if(NOT mocFiles)
+  set(RunCMake_TEST_FAILED "Expected moc output moc_moc_content.cpp missing.")
+  return()
+endif()
+list(GET mocFiles 0 mocFile)
+file(READ "${mocFile}" mocContent)
+if(NOT mocContent MATCHES "${expect_method}")
+  set(RunCMake_TEST_FAILED
+    "Expected moc output for method ${expect_method}:\n${mocContent}")
+endif()
@@ -0,0 +1,11 @@
+enable_language(CXX)
+
+set(CMAKE_CXX_STANDARD 11)
+find_package(Qt${with_qt_version} REQUIRED COMPONENTS Core)
+
+# The header is written to the build tree by the test between builds.
+add_library(moc_content STATIC moc_content.cpp
+  "${CMAKE_CURRENT_BINARY_DIR}/moc_content.h")
+target_include_directories(moc_content PRIVATE "${CMAKE_CURRENT_BINARY_DIR}")
+target_link_libraries(moc_content Qt${with_qt_version}::Core)
+set_target_properties(moc_content PROPERTIES AUTOMOC ON AUTOGEN_VERBOSE ON)
@@ -0,0 +1,54 @@
+file(GLOB parseCacheFiles
+  "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/parse_cache_autogen.dir/ParseCache*.txt")
+if(NOT parseCacheFiles)
+  set(RunCMake_TEST_FAILED "Expected parse cache file missing.")
+  return()
+endif()
+list(GET parseCacheFiles 0 parseCacheFile)
+file(READ "${parseCacheFile}" parseCache)
+
+# Extract the entries of one file from the parse cache.
+function(get_entry var name)
+  string(REGEX MATCH "[^\n]*/${name}\n( [^\n]*\n)*" entry "${parseCache}")
+  set(${var} "${entry}" PARENT_SCOPE)
+endfunction()
+
+get_entry(header "parse_cache\\.h")
+get_entry(source "parse_cache\\.cpp")
+
+if(expect_macro)
+  if(NOT header MATCHES "\n mmc:${expect_macro}\n")
+    string(APPEND RunCMake_TEST_FAILED
+      "Expected moc macro ${expect_macro} for parse_cache.h.\n")
+  endif()
+elseif(header MATCHES "\n mmc:")
+  string(APPEND RunCMake_TEST_FAILED
+    "Expected no moc macro for parse_cache.h.\n")
+endif()
+
+if(expect_depend)
+  if(NOT header MATCHES "\n mdp:[^\n]*parse_cache_${expect_depend}\\.json\n")
+    string(APPEND RunCMake_TEST_FAILED
+      "Expected moc dependency parse_cache_${expect_depend}.json "
+      "for parse_cache.h.\n")
+  endif()
+  if(header MATCHES "\n mdp:[^\n]*parse_cache_${unexpect_depend}\\.json\n")
+    string(APPEND RunCMake_TEST_FAILED
+      "Expected no moc dependency parse_cache_${unexpect_depend}.json "
+      "for parse_cache.h.\n")
+  endif()
+endif()
+
+if(expect_uic)
+  if(NOT source MATCHES "\n uic:ui_parse_cache\\.h\n")
+    string(APPEND RunCMake_TEST_FAILED
+      "Expected uic include for parse_cache.cpp.\n")
+  endif()
+elseif(source MATCHES "\n uic:")
+  string(APPEND RunCMake_TEST_FAILED
+    "Expected no uic include for parse_cache.cpp.\n")
+endif()
+
+if(RunCMake_TEST_FAILED)
+  string(APPEND RunCMake_TEST_FAILED "Parse cache:\n${parseCache}")
+endif()
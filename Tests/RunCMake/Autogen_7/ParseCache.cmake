@@ -0,0 +1,28 @@
+enable_language(CXX)
+
+set(CMAKE_CXX_STANDARD 11)
+find_package(Qt${with_qt_version} REQUIRED COMPONENTS Core Widgets Gui)
+
+# The settings below are toggled between builds of the same tree.  The
+# sources do not change, so only the settings may refresh the parse cache.
+add_library(parse_cache STATIC parse_cache.cpp parse_cache.h parse_cache.ui)
+target_link_libraries(parse_cache Qt${with_qt_version}::Core
+                                  Qt${with_qt_version}::Widgets
+                                  Qt${with_qt_version}::Gui)
+set_target_properties(parse_cache PROPERTIES AUTOMOC ON AUTOUIC ON)
+
+if(MY_OBJECT_FIRST)
+  set_property(TARGET parse_cache PROPERTY AUTOMOC_MACRO_NAMES MY_OBJECT Q_OBJECT)
+else()
+  set_property(TARGET parse_cache PROPERTY AUTOMOC_MACRO_NAMES Q_OBJECT MY_OBJECT)
+endif()
+if(DEPEND_FILTER)
+  set_property(TARGET parse_cache PROPERTY AUTOMOC_DEPEND_FILTERS
+    "PARSE_CACHE_DEP" "PARSE_CACHE_DEP \"(parse_cache_${DEPEND_FILTER}\\.json)\"")
+endif()
+
+set_property(SOURCE parse_cache.h PROPERTY SKIP_AUTOMOC ${SKIP_AUTOMOC})
+set_property(SOURCE parse_cache.cpp PROPERTY SKIP_AUTOUIC ${SKIP_AUTOUIC})
+if(NOT SKIP_AUTOUIC)
+  target_compile_definitions(parse_cache PRIVATE PARSE_CACHE_UI)
+endif()
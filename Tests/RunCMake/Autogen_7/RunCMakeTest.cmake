@@ -7,4 +7,91 @@ if (DEFINED with_qt_version)
     "-DCMAKE_PREFIX_PATH:STRING=${CMAKE_PREFIX_PATH}"
   )
   run_cmake(AutoMocIncludeDirectories)
+
+  block()
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ParseCache-build)
+    function(parse_cache_step desc)
+      set(RunCMake_TEST_VARIANT_DESCRIPTION "-${desc}")
+      run_cmake_with_options(ParseCache ${RunCMake_TEST_OPTIONS} ${ARGN})
+      set(RunCMake_TEST_NO_CLEAN 1)
+      run_cmake_command(ParseCache-build ${CMAKE_COMMAND} --build . --config Debug)
+    endfunction()
+
+    set(expect_macro "")
+    set(expect_uic 0)
+    set(expect_depend "")
+    parse_cache_step(skipped -DSKIP_AUTOMOC=ON -DSKIP_AUTOUIC=ON)
+    set(RunCMake_TEST_NO_CLEAN 1)
+
+    set(expect_uic 1)
+    parse_cache_step(uic -DSKIP_AUTOMOC=ON -DSKIP_AUTOUIC=OFF)
+
+    set(expect_macro "Q_OBJECT")
+    parse_cache_step(moc -DSKIP_AUTOMOC=OFF)
+
+    set(expect_macro "MY_OBJECT")
+    parse_cache_step(macro-names -DMY_OBJECT_FIRST=ON)
+
+    if(QtCore_VERSION VERSION_LESS 5.15.0)
+      set(expect_depend "a")
+      set(unexpect_depend "b")
+      parse_cache_step(depend-a -DDEPEND_FILTER=a)
+
+      set(expect_depend "b")
+      set(unexpect_depend "a")
+      parse_cache_step(depend-b -DDEPEND_FILTER=b)
+    endif()
+  endblock()
+
+  block()
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/MocContentHash-build)
+    set(header "${RunCMake_TEST_BINARY_DIR}/moc_content.h")
+    function(write_header method)
+      file(WRITE "${header}" "#include <QObject>
+class MocContent : public QObject
+{
+  Q_OBJECT
+public:
+  MocContent();
+  Q_INVOKABLE void ${method}();
+};
+")
+    endfunction()
+    function(moc_content_build desc)
+      set(RunCMake_TEST_VARIANT_DESCRIPTION "-${desc}")
+      run_cmake_command(MocContentHash-build ${CMAKE_COMMAND} --build . --config Debug)
+    endfunction()
+    macro(get_parse_cache var)
+      file(GLOB ${var} "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/moc_content_autogen.dir/ParseCache*.txt")
+    endmacro()
+
+    file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+    write_header(contentA)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    run_cmake(MocContentHash)
+    set(expect_method contentA)
+    moc_content_build(first)
+
+    # Touching the header does not run moc again.
+    execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.125)
+    file(TOUCH "${header}")
+    set(RunCMake_TEST_NOT_EXPECT_stdout "moc_moc_content\\.cpp\", because")
+    moc_content_build(touch)
+    unset(RunCMake_TEST_NOT_EXPECT_stdout)
+
+    # Simulate a build that wrote the moc output for changed content but
+    # was aborted before writing the parse cache.  Reverting the content
+    # must not keep that output.
+    get_parse_cache(parseCache)
+    file(COPY_FILE "${parseCache}" "${parseCache}.saved")
+    execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.125)
+    write_header(contentB)
+    set(expect_method contentB)
+    moc_content_build(changed)
+    file(RENAME "${parseCache}.saved" "${parseCache}")
+    execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.125)
+    write_header(contentA)
+    set(expect_method contentA)
+    moc_content_build(reverted)
+  endblock()
 endif()
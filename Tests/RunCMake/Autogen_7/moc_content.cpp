@@ -0,0 +1,5 @@
+#include "moc_content.h"
+
+MocContent::MocContent()
+{
+}
@@ -0,0 +1,9 @@
+#include "parse_cache.h"
+
+#ifdef PARSE_CACHE_UI
+#  include "ui_parse_cache.h"
+#endif
+
+ParseCache::ParseCache()
+{
+}
@@ -0,0 +1,19 @@
+#ifndef PARSE_CACHE_H
+#define PARSE_CACHE_H
+
+#include <QObject>
+
+#define MY_OBJECT
+
+// PARSE_CACHE_DEP "parse_cache_a.json"
+// PARSE_CACHE_DEP "parse_cache_b.json"
+
+class ParseCache : public QObject
+{
+  Q_OBJECT
+  MY_OBJECT
+public:
+  ParseCache();
+};
+
+#endif
@@ -0,0 +1,37 @@
+if(PACKAGING_TYPE STREQUAL "COMPONENT")
+  set(EXPECTED_FILES_COUNT "4")
+  foreach(i RANGE 1 4)
+    set(EXPECTED_FILE_${i} "*-c${i}.*")
+    set(EXPECTED_FILE_CONTENT_${i}_LIST
+      "/common"
+      "/common/CMakeLists.txt"
+      "/files${i}"
+      "/files${i}/${i}.txt"
+    )
+  endforeach()
+elseif(PACKAGING_TYPE STREQUAL "GROUP")
+  set(EXPECTED_FILES_COUNT "3")
+  set(EXPECTED_FILE_1 "*-g1.*")
+  set(EXPECTED_FILE_CONTENT_1_LIST
+    "/common"
+    "/common/CMakeLists.txt"
+    "/files1"
+    "/files1/1.txt"
+    "/files2"
+    "/files2/2.txt"
+  )
+  set(EXPECTED_FILE_2 "*-g2.*")
+  set(EXPECTED_FILE_CONTENT_2_LIST
+    "/common"
+    "/common/CMakeLists.txt"
+    "/files3"
+    "/files3/3.txt"
+  )
+  set(EXPECTED_FILE_3 "*-c4.*")
+  set(EXPECTED_FILE_CONTENT_3_LIST
+    "/common"
+    "/common/CMakeLists.txt"
+    "/files4"
+    "/files4/4.txt"
+  )
+endif()
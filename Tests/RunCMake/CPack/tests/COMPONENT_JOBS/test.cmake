@@ -0,0 +1,21 @@
+foreach(i RANGE 1 4)
+  file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/${i}.txt" "This is file ${i}")
+  install(FILES "${CMAKE_CURRENT_BINARY_DIR}/${i}.txt" DESTINATION "files${i}" COMPONENT c${i})
+  # Every component also ships a common file.
+  install(FILES CMakeLists.txt DESTINATION common COMPONENT c${i})
+endforeach()
+
+set(CPACK_ARCHIVE_COMPONENT_JOBS 0)
+
+if(PACKAGING_TYPE STREQUAL "GROUP")
+  set(CPACK_COMPONENTS_GROUPING ONE_PER_GROUP)
+  set(CPACK_ARCHIVE_COMPONENT_INSTALL ON)
+  include(CPackComponent)
+
+  cpack_add_component_group(g1)
+  cpack_add_component_group(g2)
+  cpack_add_component(c1 GROUP g1)
+  cpack_add_component(c2 GROUP g1)
+  cpack_add_component(c3 GROUP g2)
+  cpack_add_component(c4)
+endif()
@@ -29,3 +29,15 @@ if (NOT numInvocations EQUAL 1)
   set(RunCMake_TEST_FAILED
       "Unexpected number of lowercase command names: ${numInvocations}")
 endif()
+
+file(STRINGS ${ProfilingTestOutput} regexCache
+  REGEX [["name"[ ]*:[ ]*"regex_cache"]])
+list(LENGTH regexCache numRegexCache)
+if (NOT numRegexCache EQUAL 1)
+  set(RunCMake_TEST_FAILED "Expected one regex_cache counter")
+endif()
+file(STRINGS ${ProfilingTestOutput} regexCacheHits
+  REGEX [=["hits"[ ]*:[ ]*[1-9]]=])
+if ("${regexCacheHits}" STREQUAL "")
+  set(RunCMake_TEST_FAILED "Expected regex_cache hits")
+endif()
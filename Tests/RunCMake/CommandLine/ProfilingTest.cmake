@@ -3,3 +3,8 @@ endfunction()
 
 # This must not appear in the profiling output as uppercase
 __TESTING_COMMAND_CASE()
+
+# Matching the same pattern again must reuse the compiled expression
+foreach(i RANGE 3)
+  string(REGEX MATCH "^[a-z]+" match "abc${i}")
+endforeach()
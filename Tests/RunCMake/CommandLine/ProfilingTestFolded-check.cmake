@@ -0,0 +1,21 @@
+if (NOT EXISTS ${ProfilingTestOutput})
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exists")
+  return()
+endif()
+
+file(READ "${ProfilingTestOutput}" content)
+if (NOT content MATCHES "^([^\n]+ [0-9]+\n)+$")
+  set(RunCMake_TEST_FAILED "Malformed folded stack output:\n${content}")
+  return()
+endif()
+
+foreach(stack
+    "project:configure;([^;\n]*;)*script:__testing_command_case \\([^;\n]*ProfilingTestFolded.cmake:4\\)"
+    "project:generate;generate:compute"
+    "project:generate;generate:generate;generate_directory:[^;\n]*;generate_target:profiled_target"
+    )
+  if (NOT content MATCHES "(^|\n)${stack} [0-9]+\n")
+    set(RunCMake_TEST_FAILED "Expected a stack matching\n  ${stack}\nin:\n${content}")
+    return()
+  endif()
+endforeach()
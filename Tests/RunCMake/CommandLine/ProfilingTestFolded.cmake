@@ -0,0 +1,5 @@
+function(__testing_command_case)
+endfunction()
+
+__testing_command_case()
+add_custom_target(profiled_target)
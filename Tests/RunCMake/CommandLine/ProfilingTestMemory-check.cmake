@@ -0,0 +1,10 @@
+if (NOT EXISTS ${ProfilingTestOutput})
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exists")
+  return()
+endif()
+
+file(STRINGS ${ProfilingTestOutput} memoryCounters
+  REGEX [["name"[ ]*:[ ]*"memory"]])
+if (memoryCounters STREQUAL "")
+  set(RunCMake_TEST_FAILED "Expected memory counter events")
+endif()
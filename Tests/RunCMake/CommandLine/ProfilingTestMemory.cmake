@@ -0,0 +1,2 @@
+# Grow the memory used by the process.
+string(REPEAT "0123456789abcdef" 1048576 memory_test_value)
@@ -1149,6 +1149,22 @@ set(RunCMake_TEST_OPTIONS --profiling-format=google-trace --profiling-output=${P
 run_cmake(ProfilingTest)
 unset(RunCMake_TEST_OPTIONS)
 
+set(RunCMake_TEST_BINARY_DIR "${RunCMake_BINARY_DIR}/profiling-folded-test")
+set(ProfilingTestOutput ${RunCMake_TEST_BINARY_DIR}/output.folded)
+set(RunCMake_TEST_OPTIONS --profiling-format=folded-stack --profiling-output=${ProfilingTestOutput})
+run_cmake(ProfilingTestFolded)
+unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_OPTIONS --profiling-memory)
+run_cmake(profiling-memory-missing-output)
+unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_BINARY_DIR "${RunCMake_BINARY_DIR}/profiling-memory-test")
+set(ProfilingTestOutput ${RunCMake_TEST_BINARY_DIR}/output.json)
+set(RunCMake_TEST_OPTIONS --profiling-format=google-trace --profiling-memory --profiling-output=${ProfilingTestOutput})
+run_cmake(ProfilingTestMemory)
+unset(RunCMake_TEST_OPTIONS)
+
 run_cmake_with_options(help-arbitrary "--help" "CMAKE_CXX_IGNORE_EXTENSIONS")
 
 if (WIN32 OR DEFINED ENV{HOME})
@@ -6,7 +6,7 @@ function(instrument test)
   set(config "${CMAKE_CURRENT_LIST_DIR}/config")
   set(ENV{CMAKE_CONFIG_DIR} ${config})
   cmake_parse_arguments(ARGS
-    "BUILD;BUILD_MAKE_PROGRAM;INSTALL;TEST;COPY_QUERIES;NO_WARN;STATIC_QUERY;DYNAMIC_QUERY;INSTALL_PARALLEL;MANUAL_HOOK"
+    "BUILD;BUILD_MAKE_PROGRAM;INSTALL;TEST;COPY_QUERIES;NO_WARN;STATIC_QUERY;DYNAMIC_QUERY;INSTALL_PARALLEL;MANUAL_HOOK;SUMMARY;CODEMODEL"
     "CHECK_SCRIPT;CONFIGURE_ARG" "" ${ARGN})
   set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/${test})
   set(uuid "a37d1069-1972-4901-b9c9-f194aaf2b6e0")
@@ -17,6 +17,11 @@ function(instrument test)
   # We can't use RunCMake_TEST_NO_CLEAN 0 because we preserve queries placed in the build tree after
   file(REMOVE_RECURSE ${RunCMake_TEST_BINARY_DIR})
 
+  # Request the codemodel from which target dependencies are read
+  if (ARGS_CODEMODEL)
+    file(WRITE ${RunCMake_TEST_BINARY_DIR}/.cmake/api/v1/query/codemodel-v2 "")
+  endif()
+
   # Set hook command
   set(static_query_hook_arg 0)
   if (ARGS_STATIC_QUERY)
@@ -73,6 +78,9 @@ function(instrument test)
   if (ARGS_MANUAL_HOOK)
     run_cmake_command(${test}-index ${CMAKE_CTEST_COMMAND} --collect-instrumentation .)
   endif()
+  if (ARGS_SUMMARY)
+    run_cmake_command(${test}-summary ${CMAKE_CTEST_COMMAND} --summarize-instrumentation .)
+  endif()
 
   # Run Post-Test Checks
   # Check scripts need to run after ALL run_cmake_command have finished
@@ -103,6 +111,8 @@ instrument(dynamic-query BUILD INSTALL TEST DYNAMIC_QUERY
   CHECK_SCRIPT check-data-dir.cmake)
 instrument(both-query BUILD INSTALL TEST DYNAMIC_QUERY
   CHECK_SCRIPT check-data-dir.cmake)
+instrument(snippet-log BUILD SUMMARY CODEMODEL
+  CHECK_SCRIPT check-snippet-log.cmake)
 
 # cmake_instrumentation command
 instrument(cmake-command
@@ -0,0 +1,35 @@
+include(${CMAKE_CURRENT_LIST_DIR}/verify-snippet.cmake)
+
+file(GLOB snippets ${v1}/data/*.json)
+if (snippets)
+  add_error("Unexpected snippet files generated with the snippetLog query:\n${snippets}")
+endif()
+
+set(log ${v1}/data/snippets.jsonl)
+if (NOT EXISTS ${log})
+  add_error("No snippet log generated")
+  return()
+endif()
+
+set(FOUND_SNIPPETS "")
+file(STRINGS ${log} records)
+foreach(record IN LISTS records)
+  string(JSON snippet ERROR_VARIABLE noSnippet GET "${record}" snippet)
+  if (NOT noSnippet MATCHES NOTFOUND)
+    add_error("Snippet log record missing snippet name:\n${record}")
+    continue()
+  endif()
+
+  # Verify the record is a valid snippet
+  verify_snippet("${snippet}" "${record}")
+
+  if (NOT role IN_LIST FOUND_SNIPPETS)
+    list(APPEND FOUND_SNIPPETS ${role})
+  endif()
+endforeach()
+
+foreach(role IN ITEMS configure generate compile link custom cmakeBuild)
+  if (NOT role IN_LIST FOUND_SNIPPETS)
+    add_error("No snippet of role \"${role}\" was found in ${log}")
+  endif()
+endforeach()
@@ -0,0 +1,13 @@
+set(stamp "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake.stamp")
+if(NOT EXISTS "${stamp}")
+  set(RunCMake_TEST_FAILED "Build system check did not write:\n  ${stamp}")
+  return()
+endif()
+file(READ "${stamp}" content)
+if(NOT content MATCHES "[0-9]+ ([^\n]*/)?input.txt\n")
+  set(RunCMake_TEST_FAILED "Stamp does not record input.txt:\n${content}")
+endif()
+
+# Remember when the stamp was written to tell whether later checks skip.
+file(TIMESTAMP "${stamp}" stamp_time "%Y-%m-%dT%H:%M:%S.%f")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/stamp-time.txt" "${stamp_time}")
@@ -0,0 +1,13 @@
+if(actual_stdout MATCHES "input='")
+  set(RunCMake_TEST_FAILED "No-op build regenerated the build system:\n${actual_stdout}")
+  return()
+endif()
+
+# A check that finds the stamp current returns without rewriting it.
+set(stamp "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake.stamp")
+file(TIMESTAMP "${stamp}" stamp_time "%Y-%m-%dT%H:%M:%S.%f")
+file(READ "${RunCMake_TEST_BINARY_DIR}/stamp-time.txt" expect_time)
+if(NOT stamp_time STREQUAL expect_time)
+  set(RunCMake_TEST_FAILED "No-op build rewrote the stamp:\n  ${stamp}\n"
+    "Expected modification time '${expect_time}', got '${stamp_time}'.")
+endif()
@@ -0,0 +1,18 @@
+if(actual_stdout MATCHES "input='")
+  set(RunCMake_TEST_FAILED "Build after regeneration regenerated again:\n${actual_stdout}")
+  return()
+endif()
+
+# The stamp left by the check before input.txt changed is stale, so the
+# full check runs again and records the new time of input.txt.
+set(stamp "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake.stamp")
+file(TIMESTAMP "${stamp}" stamp_time "%Y-%m-%dT%H:%M:%S.%f")
+file(READ "${RunCMake_TEST_BINARY_DIR}/stamp-time.txt" old_time)
+if(stamp_time STREQUAL old_time)
+  set(RunCMake_TEST_FAILED "Build after input.txt changed kept the stamp:\n  ${stamp}")
+  return()
+endif()
+file(READ "${stamp}" content)
+if(NOT content MATCHES "(^|\n)[0-9]+ ([^\n]*/)?input.txt\n")
+  set(RunCMake_TEST_FAILED "Stamp does not record input.txt:\n${content}")
+endif()
@@ -0,0 +1,7 @@
+if(NOT EXISTS ${CMAKE_BINARY_DIR}/input.txt)
+  file(WRITE ${CMAKE_BINARY_DIR}/input.txt "1")
+endif()
+set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${CMAKE_BINARY_DIR}/input.txt)
+file(READ ${CMAKE_BINARY_DIR}/input.txt input)
+message(STATUS "input='${input}'")
+add_custom_target(drive ALL)
@@ -41,6 +41,19 @@ run_VerboseBuild()
 
 run_cmake(IncludeRegexSubdir)
 
+function(run_CheckBuildSystemStamp)
+  run_cmake(CheckBuildSystemStamp)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CheckBuildSystemStamp-build)
+  run_cmake_command(CheckBuildSystemStamp-build ${CMAKE_COMMAND} --build .)
+  run_cmake_command(CheckBuildSystemStamp-nowork ${CMAKE_COMMAND} --build .)
+  # A changed input must regenerate despite the stamp of the previous check.
+  file(WRITE ${RunCMake_TEST_BINARY_DIR}/input.txt "2")
+  run_cmake_command(CheckBuildSystemStamp-rebuild ${CMAKE_COMMAND} --build .)
+  run_cmake_command(CheckBuildSystemStamp-recheck ${CMAKE_COMMAND} --build .)
+endfunction()
+run_CheckBuildSystemStamp()
+
 function(run_MakefileConflict)
   run_cmake(MakefileConflict)
   set(RunCMake_TEST_NO_CLEAN 1)
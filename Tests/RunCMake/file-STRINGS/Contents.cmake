@@ -0,0 +1,59 @@
+function(check expect mode file)
+  if(mode STREQUAL "STRINGS")
+    file(STRINGS "${file}" actual ${ARGN})
+  else()
+    file(READ "${file}" actual ${ARGN})
+  endif()
+  if(NOT actual STREQUAL expect)
+    message(SEND_ERROR "file(${mode} ${ARGN}) of\n  ${file}\n"
+      "gave\n  \"${actual}\"\nnot\n  \"${expect}\"")
+  endif()
+endfunction()
+
+set(bin "${CMAKE_CURRENT_LIST_DIR}/Contents.bin")
+set(utf16 "${CMAKE_CURRENT_LIST_DIR}/Contents-UTF-16LE.bin")
+set(txt "${CMAKE_CURRENT_BINARY_DIR}/Contents.txt")
+file(WRITE "${txt}" "one\r\ntwo\nthree\r")
+string(REPEAT A 16 A16)
+string(REPEAT A 100 A100)
+
+# Files in the build tree are read as streams instead of being mapped.
+set(bin_copy "${CMAKE_CURRENT_BINARY_DIR}/Contents.bin")
+file(COPY_FILE "${bin}" "${bin_copy}")
+foreach(contents IN ITEMS "${bin}" "${bin_copy}")
+  check("lead;version=1.2.3;second line\twith tab;${A100};h;llo;(;\\;semi\\;colon;x;;end" STRINGS ${contents})
+  check("version=1.2.3;second line\twith tab;${A100};\\;semi\\;colon" STRINGS ${contents} LENGTH_MINIMUM 5)
+  check("lead;version=1.2.3;second line\twith; tab;${A16};${A16};${A16};${A16};${A16};${A16};AAAA;h;llo;(;\\;semi\\;colon;x;;end" STRINGS ${contents} LENGTH_MAXIMUM 16)
+  check("lead;version=1.2.3;second lin" STRINGS ${contents} LIMIT_INPUT 30)
+  check("lead;version=1.2.3;second line\twith tab" STRINGS ${contents} LIMIT_COUNT 3)
+  check("lead;version=1.2.3" STRINGS ${contents} LIMIT_OUTPUT 40)
+  check("lead;version=1.2.3\nsecond line\twith tab;${A100};h;llo;(;\\;semi\\;colon;x\n\nend" STRINGS ${contents} NEWLINE_CONSUME)
+  check("lead;version=1.2.3;second line\twith tab;${A100};héllo;(;\\;semi\\;colon;x;;end" STRINGS ${contents} ENCODING UTF-8)
+  check("version=1.2.3" STRINGS ${contents} REGEX "^[a-z]+=")
+endforeach()
+check("ab;cd;ef" STRINGS ${utf16})
+check("one\ntwo\nthree" READ ${txt})
+check("one\nt\n" READ ${txt} LIMIT 5)
+check("e\ntwo\n" READ ${txt} OFFSET 2 LIMIT 6)
+check("" READ ${txt} OFFSET -1)
+check("" READ ${txt} OFFSET 100)
+check("0d0a7477" READ ${txt} HEX OFFSET 3 LIMIT 4)
+check("6c65616400766572" READ ${bin} HEX LIMIT 8)
+
+# Characters are not split where a stream is read in blocks.
+string(REPEAT a 65535 a65535)
+set(big "${CMAKE_CURRENT_BINARY_DIR}/Contents-big.txt")
+file(WRITE "${big}" "${a65535}éb\n")
+check("${a65535}éb" STRINGS ${big} ENCODING UTF-8)
+
+# The matches are those of the last string accepted.
+cmake_policy(SET CMP0159 NEW)
+set(CMAKE_MATCH_1 "unset")
+file(STRINGS "${bin}" out REGEX "([a-z]+)=([0-9.]+)|(t)ab$")
+if(NOT out STREQUAL "version=1.2.3;second line\twith tab" OR
+   NOT CMAKE_MATCH_COUNT EQUAL 3 OR NOT CMAKE_MATCH_0 STREQUAL "tab" OR
+   NOT CMAKE_MATCH_1 STREQUAL "" OR NOT CMAKE_MATCH_3 STREQUAL "t")
+  message(SEND_ERROR "file(STRINGS REGEX) stored matches\n"
+    "  ${CMAKE_MATCH_COUNT} [${CMAKE_MATCH_0}] [${CMAKE_MATCH_1}] "
+    "[${CMAKE_MATCH_3}]\nfor\n  ${out}")
+endif()
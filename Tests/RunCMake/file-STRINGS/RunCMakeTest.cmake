@@ -3,3 +3,4 @@ include(RunCMake)
 run_cmake(CMP0159-WARN)
 run_cmake(CMP0159-OLD)
 run_cmake(CMP0159-NEW)
+run_cmake(Contents)
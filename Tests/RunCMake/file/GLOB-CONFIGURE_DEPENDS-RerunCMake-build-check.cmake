@@ -0,0 +1,11 @@
+set(data "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.txt")
+if(NOT EXISTS "${data}")
+  set(RunCMake_TEST_FAILED "Glob verification data not written:\n  ${data}")
+  return()
+endif()
+file(READ "${data}" content)
+if(NOT content MATCHES "\nglob 1 0 0 [^\n]*/test/\\*\n")
+  set(RunCMake_TEST_FAILED "Data does not record the glob:\n${content}")
+elseif(NOT content MATCHES "\ndirectory [0-9]+ [^\n]*/test/\n")
+  set(RunCMake_TEST_FAILED "Data does not record the test directory:\n${content}")
+endif()
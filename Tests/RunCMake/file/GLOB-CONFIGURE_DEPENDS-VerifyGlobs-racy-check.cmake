@@ -0,0 +1,7 @@
+# The test directory was modified just before configuration listed it, so
+# it is listed again and the data are rewritten with the new listing time.
+file(TIMESTAMP "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.txt"
+  actual_time "%Y-%m-%dT%H:%M:%S.%f")
+if(actual_time STREQUAL data_time)
+  set(RunCMake_TEST_FAILED "Racy test directory was not listed again.")
+endif()
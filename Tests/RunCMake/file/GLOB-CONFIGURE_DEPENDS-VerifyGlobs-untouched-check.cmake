@@ -0,0 +1,7 @@
+# Nothing changed since the test directory was listed long enough after its
+# modification, so the glob is not repeated and the data are not rewritten.
+file(TIMESTAMP "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.txt"
+  actual_time "%Y-%m-%dT%H:%M:%S.%f")
+if(NOT actual_time STREQUAL data_time)
+  set(RunCMake_TEST_FAILED "Untouched test directory was listed again.")
+endif()
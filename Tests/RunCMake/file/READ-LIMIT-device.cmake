@@ -0,0 +1,11 @@
+# Only the bytes requested are read from a device that never ends.
+file(READ /dev/zero out LIMIT 16 HEX)
+if(NOT out STREQUAL "00000000000000000000000000000000")
+  message(FATAL_ERROR "file(READ /dev/zero LIMIT 16 HEX) gave\n  ${out}")
+endif()
+
+file(READ /dev/urandom out OFFSET 8 LIMIT 4 HEX)
+string(LENGTH "${out}" length)
+if(NOT length EQUAL 8)
+  message(FATAL_ERROR "file(READ /dev/urandom LIMIT 4 HEX) gave\n  ${out}")
+endif()
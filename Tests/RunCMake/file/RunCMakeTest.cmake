@@ -94,6 +94,10 @@ if(NOT WIN32
   run_cmake(READ_SYMLINK)
   run_cmake(READ_SYMLINK-noexist)
   run_cmake(READ_SYMLINK-notsymlink)
+  set(RunCMake_TEST_TIMEOUT 60)
+  run_cmake_script(READ-LIMIT-device)
+  run_cmake_script(STRINGS-LIMIT_INPUT-device)
+  unset(RunCMake_TEST_TIMEOUT)
   if(NOT CYGWIN)
     run_cmake(INSTALL-FOLLOW_SYMLINK_CHAIN)
   endif()
@@ -185,4 +189,27 @@ else()
   unset(RunCMake_TEST_BINARY_DIR)
   unset(RunCMake_TEST_NO_CLEAN)
   unset(RunCMake_DEFAULT_stderr)
+
+  # Run the incremental glob verification directly.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/GLOB-CONFIGURE_DEPENDS-VerifyGlobs-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(data "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.txt")
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/test/1.txt" "1")
+  run_cmake(GLOB-CONFIGURE_DEPENDS-VerifyGlobs)
+
+  # Configuration listed the test directory right after it was modified.
+  # Wait until it can be trusted, and check it is listed again.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 2.25)
+  file(TIMESTAMP "${data}" data_time "%Y-%m-%dT%H:%M:%S.%f")
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-VerifyGlobs-racy ${CMAKE_COMMAND} -E cmake_verify_globs "${data}")
+
+  file(TIMESTAMP "${data}" data_time "%Y-%m-%dT%H:%M:%S.%f")
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-VerifyGlobs-untouched ${CMAKE_COMMAND} -E cmake_verify_globs "${data}")
+
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/test/2.txt" "2")
+  run_cmake_command(GLOB-CONFIGURE_DEPENDS-VerifyGlobs-changed ${CMAKE_COMMAND} -E cmake_verify_globs "${data}")
+
+  unset(RunCMake_TEST_BINARY_DIR)
+  unset(RunCMake_TEST_NO_CLEAN)
 endif()
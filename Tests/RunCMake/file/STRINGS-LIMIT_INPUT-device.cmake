@@ -0,0 +1,5 @@
+# Only the bytes allowed are read from a device that never ends.
+file(STRINGS /dev/zero out LIMIT_INPUT 100)
+if(NOT out STREQUAL "")
+  message(FATAL_ERROR "file(STRINGS /dev/zero LIMIT_INPUT 100) gave\n  ${out}")
+endif()
@@ -0,0 +1,44 @@
+macro(collect out first)
+  set(calls "${calls};${ARGC}")
+  list(APPEND ${out} ${first})
+  set(plain "unchanged")
+  set(${out}_rest ${ARGN})
+  if("${ARGV1}" STREQUAL "stop")
+    return()
+  endif()
+  set(reached ${out})
+endmacro()
+
+set(calls "")
+collect(items a b c)
+if(NOT items STREQUAL "a" OR NOT items_rest STREQUAL "b;c" OR
+   NOT plain STREQUAL "unchanged" OR NOT reached STREQUAL "items")
+  message(FATAL_ERROR "failed")
+endif()
+
+function(run)
+  collect(others stop)
+  message(FATAL_ERROR "return() in the macro did not return")
+endfunction()
+run()
+
+collect(items d)
+if(NOT items STREQUAL "a;d" OR NOT calls STREQUAL ";4;2")
+  message(FATAL_ERROR "failed: ${items} ${calls}")
+endif()
+
+# A macro redefined while it runs keeps running its old body.
+macro(redefine)
+  macro(redefine)
+    set(redefined new)
+  endmacro()
+  set(redefined old)
+endmacro()
+redefine()
+if(NOT redefined STREQUAL "old")
+  message(FATAL_ERROR "failed")
+endif()
+redefine()
+if(NOT redefined STREQUAL "new")
+  message(FATAL_ERROR "failed")
+endif()
@@ -0,0 +1,77 @@
+list(APPEND test)
+if(DEFINED test)
+    message(FATAL_ERROR "failed")
+endif()
+
+list(APPEND test satu)
+list(APPEND test dua "tiga;empat")
+if(NOT test STREQUAL "satu;dua;tiga;empat")
+    message(FATAL_ERROR "failed")
+endif()
+
+list(LENGTH test length)
+list(GET test 1 -1 items)
+if(NOT length EQUAL 4 OR NOT items STREQUAL "dua;empat")
+    message(FATAL_ERROR "failed")
+endif()
+
+list(PREPEND test nol)
+list(APPEND test "")
+list(LENGTH test length)
+list(GET test 0 5 items)
+if(NOT length EQUAL 6 OR NOT items STREQUAL "nol;")
+    message(FATAL_ERROR "failed")
+endif()
+
+set(items "")
+foreach(item IN LISTS test)
+    string(APPEND items "<${item}>")
+endforeach()
+if(NOT items STREQUAL "<nol><satu><dua><tiga><empat><>")
+    message(FATAL_ERROR "failed")
+endif()
+
+# Semicolons escaped or nested in brackets do not separate elements
+list(APPEND test "[a;b" "c]" "d\;e")
+list(LENGTH test length)
+list(GET test -2 -1 items)
+if(NOT length EQUAL 8 OR NOT items STREQUAL "[a;b;c];d;e")
+    message(FATAL_ERROR "failed")
+endif()
+
+# Scope test
+set(test satu)
+list(APPEND test dua)
+function(foo)
+    list(APPEND test tiga)
+    if(NOT test STREQUAL "satu;dua;tiga")
+        message(FATAL_ERROR "failed")
+    endif()
+    set(test "${test}" PARENT_SCOPE)
+endfunction()
+
+foo()
+list(APPEND test empat)
+
+if(NOT test STREQUAL "satu;dua;tiga;empat")
+    message(FATAL_ERROR "failed")
+endif()
+
+block()
+    list(APPEND test lima)
+endblock()
+
+if(NOT test STREQUAL "satu;dua;tiga;empat")
+    message(FATAL_ERROR "failed")
+endif()
+
+# Cache entries are read when no variable is set
+set(cached satu CACHE STRING "")
+list(APPEND cached dua)
+if(NOT cached STREQUAL "satu;dua")
+    message(FATAL_ERROR "failed")
+endif()
+unset(cached)
+if(NOT cached STREQUAL "satu")
+    message(FATAL_ERROR "failed")
+endif()
@@ -0,0 +1,2 @@
+list(APPEND mylist alpha bravo charlie)
+list(GET mylist -4 result)
@@ -10,6 +10,7 @@ run_cmake(InvalidSubcommand)
 
 run_cmake(FILTER-REGEX-InvalidRegex)
 run_cmake(GET-InvalidIndex)
+run_cmake(GET-InvalidIndex-APPEND)
 run_cmake(INSERT-InvalidIndex)
 run_cmake(REMOVE_AT-InvalidIndex)
 run_cmake(SUBLIST-InvalidIndex)
@@ -105,6 +106,9 @@ run_cmake(SORT-NoCaseOption)
 # Successful tests
 run_cmake(SORT)
 
+# Successful tests
+run_cmake(APPEND)
+
 # argument tests
 run_cmake(PREPEND-NoArgs)
 # Successful tests
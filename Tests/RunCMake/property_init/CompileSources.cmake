@@ -147,6 +147,7 @@ set(properties
   ## Autogen
   "AUTOGEN_ORIGIN_DEPENDS"                  "OFF"               "<SAME>"
   "AUTOGEN_PARALLEL"                        "ON"                "<SAME>"
+  "AUTOGEN_USE_JOBSERVER"                   "ON"                "<SAME>"
   "AUTOGEN_USE_SYSTEM_INCLUDE"              "ON"                "<SAME>"
   ## moc
   "AUTOMOC_DEPEND_FILTERS"                  "FIRST<SEMI>SECOND" "<SAME>"
@@ -0,0 +1,2 @@
+set(CMAKE_REGEX_ENGINE PCRE)
+string(REGEX MATCH "a" out "a")
@@ -0,0 +1,40 @@
+set(CMAKE_REGEX_ENGINE LINEAR)
+
+# The linear engine must report the same matches.
+include(${CMAKE_CURRENT_LIST_DIR}/RegexEmptyMatch.cmake)
+
+string(REGEX MATCH "(a|ab)(c|bcd)(d*)" out "abcd")
+check_output(out "abcd")
+check_output(CMAKE_MATCH_1 "a")
+check_output(CMAKE_MATCH_2 "bcd")
+check_output(CMAKE_MATCH_3 "")
+check_output(CMAKE_MATCH_COUNT "2")
+
+string(REGEX REPLACE "([a-z]+)=([0-9]+)" "\\2:\\1" out "a=1, bc=23")
+check_output(out "1:a, 23:bc")
+
+list(TRANSFORM out REPLACE "^([0-9]+)" "<\\1>")
+check_output(out "<1>:a, 23:bc")
+
+if(NOT "x.y" MATCHES "^([a-z])\\.([a-z])$")
+  message(FATAL_ERROR "if(MATCHES) did not match")
+endif()
+check_output(CMAKE_MATCH_2 "y")
+
+# Backtracking over every split of the input between the alternatives
+# would not finish.
+string(REPEAT "a" 200 input)
+string(REGEX MATCH "^(a|aa)+$b" out "${input}")
+check_output(out "")
+
+set(items "a1;b2;aa3;c")
+list(FILTER items INCLUDE REGEX "^(a|aa)[0-9]$")
+check_output(items "a1;aa3")
+
+cmake_policy(SET CMP0159 NEW)
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/strings.txt" "x=1\ny=22\nz\n")
+file(STRINGS "${CMAKE_CURRENT_BINARY_DIR}/strings.txt" lines
+  REGEX "^([a-z])=([0-9]+)$")
+check_output(lines "x=1;y=22")
+check_output(CMAKE_MATCH_1 "y")
+check_output(CMAKE_MATCH_2 "22")
@@ -44,6 +44,8 @@ run_cmake(UuidBadType)
 run_cmake(RegexClear)
 run_cmake(RegexMultiMatchClear)
 run_cmake(RegexEmptyMatch)
+run_cmake(RegexEngineLinear)
+run_cmake(RegexEngineInvalid)
 run_cmake(CMP0186)
 
 run_cmake(UTF-16BE)